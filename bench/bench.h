@@ -0,0 +1,197 @@
+// ============================================
+// Structa benchmark harness
+// ============================================
+// Shared by bench_main.cpp and bench_validation.cpp. Each case runs a short
+// warm-up and then a timed loop. On the host it reports ns/op, heap
+// allocations/op (malloc, calloc and realloc calls) and the peak heap bytes
+// held above the starting point, counted by wrapping glibc's allocator. On a
+// board it reports micros() per op and the free-heap delta across the loop
+// (ESP32/ESP8266; other boards report no heap figures).
+#ifndef STRUCTA_BENCH_H
+#define STRUCTA_BENCH_H
+
+#include <Arduino.h>
+
+#ifndef STRUCTA_BENCH_ITERATIONS
+#ifdef ARDUINO
+#define STRUCTA_BENCH_ITERATIONS 500
+#else
+#define STRUCTA_BENCH_ITERATIONS 20000
+#endif
+#endif
+
+#if !defined(ARDUINO) && defined(__GLIBC__)
+#define STRUCTA_BENCH_COUNT_HEAP 1
+#include <malloc.h>
+#include <chrono>
+#else
+#define STRUCTA_BENCH_COUNT_HEAP 0
+#endif
+
+namespace StructaBench {
+
+struct HeapCounters {
+    bool enabled;
+    unsigned long allocations;
+    long current;
+    long peak;
+};
+
+// Zero-initialised at load time, so the allocator hooks can use it at any point
+static HeapCounters heap;
+static unsigned long iterations = STRUCTA_BENCH_ITERATIONS;
+static unsigned failures = 0;
+static volatile size_t sink = 0;
+
+inline size_t freeHeap() {
+#if defined(ESP32) || defined(ESP8266)
+    return ESP.getFreeHeap();
+#else
+    return 0;
+#endif
+}
+
+inline void noteAllocated(size_t bytes) {
+    if (!heap.enabled) return;
+    heap.allocations++;
+    heap.current += (long)bytes;
+    if (heap.current > heap.peak) heap.peak = heap.current;
+}
+
+inline void noteReleased(size_t bytes) {
+    if (heap.enabled) heap.current -= (long)bytes;
+}
+
+// Records a failed round-trip check; the host binary then exits non-zero
+inline bool check(bool ok, const char* what) {
+    if (!ok) {
+        failures++;
+        Serial.print("FAIL: ");
+        Serial.println(what);
+    }
+    return ok;
+}
+
+inline void printPadded(const char* text, size_t width) {
+    size_t n = strlen(text);
+    Serial.print(text);
+    while (n++ < width) Serial.print(' ');
+}
+
+inline void printHeader(const char* title) {
+    Serial.println();
+    Serial.print("== ");
+    Serial.print(title);
+    Serial.print(" (");
+    Serial.print(iterations);
+    Serial.println(" iterations) ==");
+#ifdef ARDUINO
+    printPadded("case", 52);
+    Serial.println("us/op      heap delta");
+#else
+    printPadded("case", 52);
+    Serial.println("ns/op      allocs/op  peak bytes");
+#endif
+}
+
+// fn() returns something convertible to size_t (a length, a flag) so the
+// work cannot be optimised away
+template<typename Fn>
+void run(const char* name, Fn fn) {
+    for (int i = 0; i < 8; i++) sink += (size_t)fn();
+
+#ifdef ARDUINO
+    size_t heapBefore = freeHeap();
+    unsigned long start = micros();
+    for (unsigned long i = 0; i < iterations; i++) sink += (size_t)fn();
+    unsigned long elapsed = micros() - start;
+    long heapDelta = (long)heapBefore - (long)freeHeap();
+
+    printPadded(name, 52);
+    Serial.print((double)elapsed / iterations, 2);
+    Serial.print("     ");
+    if (heapBefore) Serial.println(heapDelta);
+    else Serial.println("n/a");
+#else
+    heap.allocations = 0;
+    heap.current = heap.peak = 0;
+    heap.enabled = true;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < iterations; i++) sink += (size_t)fn();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    heap.enabled = false;
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    printPadded(name, 52);
+    char row[64];
+    if (STRUCTA_BENCH_COUNT_HEAP) {
+        snprintf(row, sizeof(row), "%-10.1f %-10.2f %ld", ns / iterations,
+                 (double)heap.allocations / iterations, heap.peak);
+    } else {
+        snprintf(row, sizeof(row), "%-10.1f n/a        n/a", ns / iterations);
+    }
+    Serial.println(row);
+#endif
+}
+
+} // namespace StructaBench
+
+#if STRUCTA_BENCH_COUNT_HEAP
+// Route the C allocator through the counters; operator new and ArduinoJson's
+// DynamicJsonDocument both end up here
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    if (ptr) StructaBench::noteAllocated(malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    if (ptr) StructaBench::noteAllocated(malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    size_t before = ptr ? malloc_usable_size(ptr) : 0;
+    void* grown = __libc_realloc(ptr, size);
+    if (grown) {
+        StructaBench::noteReleased(before);
+        StructaBench::noteAllocated(malloc_usable_size(grown));
+    }
+    return grown;
+}
+
+void free(void* ptr) {
+    if (ptr) StructaBench::noteReleased(malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+}
+#endif
+
+// Entry point: setup() on a board, main([iterations]) on the host
+#ifdef ARDUINO
+#define STRUCTA_BENCH_MAIN(runAll)                                           \
+    void setup() {                                                           \
+        Serial.begin(115200);                                                \
+        delay(1000);                                                         \
+        runAll();                                                            \
+        Serial.println(StructaBench::failures ? "FAILED" : "DONE");          \
+    }                                                                        \
+    void loop() {}
+#else
+#define STRUCTA_BENCH_MAIN(runAll)                                           \
+    int main(int argc, char** argv) {                                        \
+        if (argc > 1) StructaBench::iterations = strtoul(argv[1], nullptr, 10); \
+        if (!StructaBench::iterations) StructaBench::iterations = 1;         \
+        runAll();                                                            \
+        return StructaBench::failures ? 1 : 0;                               \
+    }
+#endif
+
+#endif // STRUCTA_BENCH_H
@@ -0,0 +1,323 @@
+// Benchmarks for structa.h: the person example models, a nested struct built
+// from them and a DEFINE_STRUCTA_WITH_VALIDATION variant, through every
+// encoding, the reusable contexts, deltas and peer frames.
+// Build with -I../src -I../examples/person (see Makefile); the Makefile also
+// builds it with STRUCTA_INLINE_FIELDS=1 to time the inline expansion.
+#include "bench.h"
+#include "dataModel.h"
+
+#define HOUSEHOLD_FIELDS(f) \
+  f(person, owner)          \
+  f(configs, router)        \
+  f(int, rooms)
+
+DEFINE_STRUCTA(household, HOUSEHOLD_FIELDS)
+
+#define CHECKED_PERSON_VALIDATORS(v)         \
+  v(id, makeRequiredValidator())             \
+  v(name, makeStringLengthValidator(1, 32))  \
+  v(age, makeRangeValidatorInt(0, 150))      \
+  v(weight, makeRangeValidatorFloat(0, 500))
+
+DEFINE_STRUCTA_WITH_VALIDATION(checkedPerson, fields, CHECKED_PERSON_VALIDATORS)
+
+#define CLIMATE_FIELDS(f)                  \
+  f(float, temperature, META_FIXED(1))     \
+  f(float, pressure, META_SCALED(100))     \
+  f(int, station)
+
+DEFINE_STRUCTA(climate, CLIMATE_FIELDS)
+
+// Field rules: a delta carries only some keys, so patches are checked key
+// by key rather than as a whole document
+#define READING_FIELDS(f)                  \
+  f(float, temp, META_RANGE(-40, 85))      \
+  f(String, site, META_STRLEN(2, 16))      \
+  f(int, samples)
+
+DEFINE_STRUCTA(reading, READING_FIELDS)
+
+// A later firmware's person: age moved last and a field added, so its
+// compact frames only decode through a learned peer schema
+#define PERSON_V2_FIELDS(f) \
+  f(String, id)             \
+  f(String, name)           \
+  f(float, weight)          \
+  f(String, team)           \
+  f(int, age)
+
+DEFINE_STRUCTA(personV2, PERSON_V2_FIELDS)
+
+static person makePerson() {
+    person p;
+    p.id = "magx-01";
+    p.name = "Alex Malisa";
+    p.age = 29;
+    p.weight = 92.31f;
+    return p;
+}
+
+static configs makeConfigs() {
+    configs c;
+    c.deviceName = "greenhouse-node-07";
+    c.apiKey = "9f2c4e1ab37d4c0e8a6b5d21f0c3e7aa";
+    c.ssid = "field-station";
+    c.debug = false;
+    return c;
+}
+
+static household makeHousehold() {
+    household h;
+    h.owner = makePerson();
+    h.router = makeConfigs();
+    h.rooms = 4;
+    return h;
+}
+
+static checkedPerson makeCheckedPerson() {
+    checkedPerson p;
+    p.id = "magx-02";
+    p.name = "Sam Okafor";
+    p.age = 41;
+    p.weight = 78.5f;
+    return p;
+}
+
+static reading makeReading() {
+    reading r;
+    r.temp = 21.5f;
+    r.site = "greenhouse";
+    r.samples = 12;
+    return r;
+}
+
+static climate makeClimate() {
+    climate c;
+    c.temperature = -12.5f;
+    c.pressure = 1013.25f;
+    c.station = 7;
+    return c;
+}
+
+// Encoded floats: negative values round away from zero, values beyond the
+// int32_t range saturate at its limits and NaN is written as 0
+static void checkEncodedFloats() {
+    using namespace StructaBench;
+    climate c = makeClimate();
+    c.temperature = -40.25f;
+    check(c.serialize() == "{\"temperature\":-40.3,\"pressure\":101325,\"station\":7}",
+          "climate negative META_FIXED");
+    c.temperature = 1e12f;
+    c.pressure = -1e12f;
+    check(c.serialize() == "{\"temperature\":214748364.7,\"pressure\":-2147483648,\"station\":7}",
+          "climate saturates out-of-range values");
+    c.temperature = NAN;
+    c.pressure = -INFINITY;
+    check(c.serialize() == "{\"temperature\":0.0,\"pressure\":-2147483648,\"station\":7}",
+          "climate non-finite values");
+    // Both read paths round META_FIXED input to its declared decimals
+    const char* negative = "{\"temperature\":-3.45,\"pressure\":-150,\"station\":1}";
+    auto parsed = climate::deserializeWithResult(negative);
+    check(parsed.success && parsed.data.temperature == -3.5f && parsed.data.pressure == -1.5f,
+          "climate negative document read");
+    parsed = climate::deserializeDirect(negative, strlen(negative));
+    check(parsed.success && parsed.data.temperature == -3.5f && parsed.data.pressure == -1.5f,
+          "climate negative direct read");
+
+    // MessagePack has no raw text, so META_FIXED travels as its value there
+    c = makeClimate();
+    uint8_t packed[64];
+    const size_t packedLength = c.serializeMsgPack(packed, sizeof(packed)).data;
+    parsed = climate::deserializeMsgPack(packed, packedLength);
+    check(packedLength > 0 && parsed.success && parsed.data.temperature == -12.5f &&
+          parsed.data.pressure == 1013.25f && parsed.data.station == 7,
+          "climate MessagePack round trip");
+}
+
+// The direct parser takes JSON numbers only: text that merely looks numeric
+// fails the read instead of decoding to some value
+static void checkDirectNumbers() {
+    using namespace StructaBench;
+    static const char* const malformed[] = {
+        "{\"age\":--1}", "{\"age\":1-2}", "{\"age\":-}", "{\"age\":1.2.3}",
+        "{\"age\":1.}", "{\"age\":.5}", "{\"age\":+1}", "{\"age\":1e}",
+    };
+    for (const char* json : malformed) {
+        String name = String("direct parse rejects ") + json;
+        check(!person::deserializeDirect(json, strlen(json)).success, name.c_str());
+    }
+    const char* valid = "{\"age\":-12,\"weight\":6.25e1}";
+    auto parsed = person::deserializeDirect(valid, strlen(valid));
+    check(parsed.success && parsed.data.age == -12 && parsed.data.weight == 62.5f, "direct parse numbers");
+}
+
+template<typename T>
+static void runCodec(const char* label, const T& value) {
+    using namespace StructaBench;
+    const String json = value.serialize();
+    auto roundTrip = T::deserializeWithResult(json);
+    check(roundTrip.success && roundTrip.data.serialize() == json, label);
+
+    char buffer[512];
+    String name;
+
+    name = String(label) + ".serialize()";
+    run(name.c_str(), [&]() { return value.serialize().length(); });
+
+    name = String(label) + ".serializeWithResult()";
+    run(name.c_str(), [&]() { return value.serializeWithResult().data.length(); });
+
+    name = String(label) + ".serialize(char*, size_t)";
+    run(name.c_str(), [&]() { return value.serialize(buffer, sizeof(buffer)); });
+
+    name = String(label) + ".deserializeWithResult()";
+    run(name.c_str(), [&]() { return T::deserializeWithResult(json).success; });
+}
+
+// MessagePack, compact frames and the direct parser against the same value
+template<typename T>
+static void runFormats(const char* label, const T& value) {
+    using namespace StructaBench;
+    const String json = value.serialize();
+    uint8_t packed[512];
+    char frame[512];
+    String name;
+
+    const size_t packedLength = value.serializeMsgPack(packed, sizeof(packed)).data;
+    auto fromPacked = T::deserializeMsgPack(packed, packedLength);
+    name = String(label) + " MessagePack round trip";
+    check(fromPacked.success && fromPacked.data.serialize() == json, name.c_str());
+
+    const size_t frameLength = value.serializeCompact(frame, sizeof(frame)).data;
+    auto fromFrame = T::deserializeCompact(reinterpret_cast<const uint8_t*>(frame), frameLength);
+    name = String(label) + " compact round trip";
+    check(fromFrame.success && fromFrame.data.serialize() == json, name.c_str());
+
+    auto direct = T::deserializeDirect(json.c_str(), json.length());
+    name = String(label) + " direct parse";
+    check(direct.success && direct.data.serialize() == json, name.c_str());
+
+    name = String(label) + ".serializeMsgPack(uint8_t*, size_t)";
+    run(name.c_str(), [&]() { return value.serializeMsgPack(packed, sizeof(packed)).data; });
+
+    name = String(label) + ".deserializeMsgPack()";
+    run(name.c_str(), [&]() { return T::deserializeMsgPack(packed, packedLength).success; });
+
+    name = String(label) + ".serializeCompact(char*, size_t)";
+    run(name.c_str(), [&]() { return value.serializeCompact(frame, sizeof(frame)).data; });
+
+    name = String(label) + ".deserializeCompact()";
+    run(name.c_str(), [&]() {
+        return T::deserializeCompact(reinterpret_cast<const uint8_t*>(frame), frameLength).success;
+    });
+
+    name = String(label) + ".deserializeDirect()";
+    run(name.c_str(), [&]() { return T::deserializeDirect(json.c_str(), json.length()).success; });
+}
+
+// A context and a pool keep the document and, for text, the output String
+// between calls, so once warm these should not allocate
+template<typename T>
+static void runReuse(const char* label, const T& value) {
+    using namespace StructaBench;
+    static StructaFixedContext<T::jsonCapacity> context;
+    static StructaDocumentPool<2, T::jsonCapacity> pool;
+    const String json = value.serialize();
+    T target;
+    String name;
+
+    name = String(label) + " context round trip";
+    check(value.serializeWithResult(context).success && context.output() == json &&
+          T::deserializeInto(context, target, json).success && target.serialize() == json,
+          name.c_str());
+
+    name = String(label) + ".serializeWithResult(context)";
+    run(name.c_str(), [&]() { return value.serializeWithResult(context).data; });
+
+    name = String(label) + ".deserializeInto(context, ...)";
+    run(name.c_str(), [&]() { return T::deserializeInto(context, target, json).success; });
+
+    name = String(label) + " pool acquire/serialize/release";
+    run(name.c_str(), [&]() {
+        StructaContext* pooled = pool.acquire();
+        size_t written = pooled ? value.serializeWithResult(*pooled).data : 0;
+        pool.release(pooled);
+        return written;
+    });
+}
+
+// Deltas between two values that differ in some fields, and the patch back
+template<typename T>
+static void runDelta(const char* label, const T& since, const T& value) {
+    using namespace StructaBench;
+    char buffer[512];
+    const String delta = value.serializeDelta(since).data;
+    T patched = since;
+    String name = String(label) + " delta round trip";
+    check(patched.applyPatch(delta).success && patched.serialize() == value.serialize(), name.c_str());
+
+    name = String(label) + ".changedFields()";
+    run(name.c_str(), [&]() { return (size_t)value.changedFields(since); });
+
+    name = String(label) + ".serializeDelta(since, char*, size_t)";
+    run(name.c_str(), [&]() { return value.serializeDelta(since, buffer, sizeof(buffer)).data; });
+
+    name = String(label) + ".applyPatch()";
+    run(name.c_str(), [&]() { return patched.applyPatch(delta).success; });
+}
+
+// Frames from a peer with another schema go through a StructaSchemaCache
+static void runPeerFrames() {
+    using namespace StructaBench;
+    static StructaSchemaCache<person> peers;
+    personV2 writer;
+    writer.id = "magx-03";
+    writer.name = "Ada Zulu";
+    writer.weight = 61.5f;
+    writer.team = "ops";
+    writer.age = 41;
+
+    char schema[256];
+    char frame[256];
+    const size_t schemaLength = personV2::serializeSchema(schema, sizeof(schema)).data;
+    const size_t frameLength = writer.serializeCompact(frame, sizeof(frame)).data;
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(frame);
+    check(!person::deserializeCompact(input, frameLength).success, "peer frame needs its schema");
+    check(peers.learn(reinterpret_cast<const uint8_t*>(schema), schemaLength).success, "peer schema learned");
+    auto mapped = person::deserializeCompact(input, frameLength, peers);
+    check(mapped.success && mapped.data.name == writer.name && mapped.data.age == 41, "peer frame mapped");
+
+    run("person.deserializeCompact(peers)", [&]() {
+        return person::deserializeCompact(input, frameLength, peers).success;
+    });
+}
+
+static void runAll() {
+#if STRUCTA_INLINE_FIELDS
+    StructaBench::printHeader("structa.h, STRUCTA_INLINE_FIELDS=1");
+#else
+    StructaBench::printHeader("structa.h");
+#endif
+    runCodec("person", makePerson());
+    runCodec("configs", makeConfigs());
+    runCodec("household", makeHousehold());
+    runCodec("checkedPerson", makeCheckedPerson());
+    checkEncodedFloats();
+    checkDirectNumbers();
+    runCodec("climate", makeClimate());
+
+    runFormats("person", makePerson());
+    runFormats("household", makeHousehold());
+    runReuse("person", makePerson());
+    runReuse("household", makeHousehold());
+    person moved = makePerson();
+    moved.age = 30;
+    moved.weight = 91.8f;
+    runDelta("person", makePerson(), moved);
+    reading warmer = makeReading();
+    warmer.temp = 24.0f;
+    runDelta("reading", makeReading(), warmer);
+    runPeerFrames();
+}
+
+STRUCTA_BENCH_MAIN(runAll)
@@ -0,0 +1,70 @@
+// Code size of the table engine against STRUCTA_INLINE_FIELDS=1: forty
+// models, each parsed, re-encoded and diffed, built once per mode. On the host
+// `make size` prints both binaries' text segments; on a board build this file
+// as a sketch with and without -DSTRUCTA_INLINE_FIELDS=1 and compare the
+// sketch sizes the IDE reports.
+#include <structa.h>
+
+#define SENSOR_FIELDS(f) \
+  f(String, id)          \
+  f(float, value)        \
+  f(uint32_t, at)        \
+  f(bool, ok)
+
+#define STATUS_FIELDS(f) \
+  f(String, device)      \
+  f(int, rssi)           \
+  f(uint16_t, uptime)    \
+  f(String, firmware)    \
+  f(bool, charging)
+
+#define LINK_FIELDS(f)   \
+  f(String, ssid)        \
+  f(String, host)        \
+  f(uint16_t, port)      \
+  f(int, interval)       \
+  f(bool, tls)
+
+#define EVENT_FIELDS(f)  \
+  f(String, kind)        \
+  f(String, source)      \
+  f(long, code)          \
+  f(float, level)        \
+  f(uint8_t, severity)   \
+  f(bool, acked)
+
+#define SIZE_MODELS(n)                     \
+  DEFINE_STRUCTA(sensor##n, SENSOR_FIELDS) \
+  DEFINE_STRUCTA(status##n, STATUS_FIELDS) \
+  DEFINE_STRUCTA(link##n, LINK_FIELDS)     \
+  DEFINE_STRUCTA(event##n, EVENT_FIELDS)
+
+SIZE_MODELS(0) SIZE_MODELS(1) SIZE_MODELS(2) SIZE_MODELS(3) SIZE_MODELS(4)
+SIZE_MODELS(5) SIZE_MODELS(6) SIZE_MODELS(7) SIZE_MODELS(8) SIZE_MODELS(9)
+
+template<typename T>
+static size_t exercise(const String& json) {
+    auto parsed = T::deserializeWithResult(json);
+    T since = parsed.data;
+    return parsed.data.serialize().length() + parsed.data.serializeDelta(since).data.length();
+}
+
+#define EXERCISE_MODELS(n) \
+    + exercise<sensor##n>(json) + exercise<status##n>(json) + exercise<link##n>(json) + exercise<event##n>(json)
+
+static size_t exerciseAll(const String& json) {
+    return 0 EXERCISE_MODELS(0) EXERCISE_MODELS(1) EXERCISE_MODELS(2) EXERCISE_MODELS(3) EXERCISE_MODELS(4)
+             EXERCISE_MODELS(5) EXERCISE_MODELS(6) EXERCISE_MODELS(7) EXERCISE_MODELS(8) EXERCISE_MODELS(9);
+}
+
+#ifdef ARDUINO
+void setup() {
+    Serial.begin(115200);
+    Serial.println(exerciseAll("{}"));
+}
+void loop() {}
+#else
+int main() {
+    return exerciseAll("{}") ? 0 : 1;
+}
+#endif
@@ -0,0 +1,44 @@
+// Benchmarks for the META validation header: the User/Address model from the
+// validation example, including its nested Address and enum/range checks.
+// Build with -I../src -I../examples/validation (see Makefile).
+#include "bench.h"
+#include <structa.h>
+#include "dataModel.h"
+
+static User makeUser() {
+    User u;
+    u.username = "malisa";
+    u.role = "admin";
+    u.age = 29;
+    u.note = "prefers metric units";
+    u.address.city = "Arusha";
+    u.address.zip = 23101;
+    return u;
+}
+
+static void runAll() {
+    using namespace StructaBench;
+    printHeader("validation/structa.h");
+
+    const User user = makeUser();
+    const String json = user.serialize();
+    auto roundTrip = User::deserializeWithResult(json);
+    check(roundTrip.success && roundTrip.data.serialize() == json, "User round trip");
+    check(!User::deserializeWithResult("{\"username\":\"x\",\"role\":\"root\",\"age\":7}").success,
+          "User rejects invalid input");
+
+    const Address address = user.address;
+    const String addressJson = address.serialize();
+
+    run("User.serialize()", [&]() { return user.serialize().length(); });
+    run("User.serializeWithResult()", [&]() { return user.serializeWithResult().data.length(); });
+    run("User.deserializeWithResult() (validated)", [&]() {
+        return User::deserializeWithResult(json).success;
+    });
+    run("Address.serialize()", [&]() { return address.serialize().length(); });
+    run("Address.deserializeWithResult()", [&]() {
+        return Address::deserializeWithResult(addressJson).success;
+    });
+}
+
+STRUCTA_BENCH_MAIN(runAll)
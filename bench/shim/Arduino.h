@@ -0,0 +1,218 @@
+// ============================================
+// Host shim for the Structa benchmarks
+// ============================================
+// Just enough of the Arduino core (String, Print, Stream, Serial, flash
+// macros, micros()) to build structa.h and ArduinoJson with g++ on a PC.
+// String keeps its text in a malloc/realloc buffer like the real WString,
+// so the allocation counts reported by the benchmark match what a board
+// would see. Serial writes to stdout.
+#ifndef STRUCTA_BENCH_ARDUINO_H
+#define STRUCTA_BENCH_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+inline void yield() {}
+
+class String {
+public:
+    String() : buffer_(nullptr), length_(0), capacity_(0) {}
+    String(const char* text) : String() { assign(text, text ? strlen(text) : 0); }
+    String(const __FlashStringHelper* text) : String(reinterpret_cast<const char*>(text)) {}
+    String(const String& other) : String() { assign(other.buffer_, other.length_); }
+    String(String&& other) : buffer_(other.buffer_), length_(other.length_), capacity_(other.capacity_) {
+        other.buffer_ = nullptr;
+        other.length_ = other.capacity_ = 0;
+    }
+    explicit String(char c) : String() { assign(&c, 1); }
+    String(int value) : String() { format("%d", value); }
+    String(unsigned value) : String() { format("%u", value); }
+    String(long value) : String() { format("%ld", value); }
+    String(unsigned long value) : String() { format("%lu", value); }
+    String(float value, unsigned char decimals = 2) : String() { format("%.*f", decimals, (double)value); }
+    String(double value, unsigned char decimals = 2) : String() { format("%.*f", decimals, value); }
+    ~String() { free(buffer_); }
+
+    String& operator=(const String& other) {
+        if (this != &other) assign(other.buffer_, other.length_);
+        return *this;
+    }
+    String& operator=(String&& other) {
+        if (this != &other) {
+            free(buffer_);
+            buffer_ = other.buffer_;
+            length_ = other.length_;
+            capacity_ = other.capacity_;
+            other.buffer_ = nullptr;
+            other.length_ = other.capacity_ = 0;
+        }
+        return *this;
+    }
+    String& operator=(const char* text) {
+        assign(text, text ? strlen(text) : 0);
+        return *this;
+    }
+
+    bool reserve(unsigned size) {
+        if (size <= capacity_ && buffer_) return true;
+        char* grown = static_cast<char*>(realloc(buffer_, size + 1));
+        if (!grown) return false;
+        if (!buffer_) grown[0] = '\0';
+        buffer_ = grown;
+        capacity_ = size;
+        return true;
+    }
+
+    bool concat(const char* text, unsigned n) {
+        if (!reserve(length_ + n)) return false;
+        memcpy(buffer_ + length_, text, n);
+        length_ += n;
+        buffer_[length_] = '\0';
+        return true;
+    }
+    bool concat(const char* text) { return text ? concat(text, (unsigned)strlen(text)) : false; }
+    bool concat(const String& other) { return concat(other.c_str(), other.length_); }
+    bool concat(char c) { return concat(&c, 1); }
+
+    String& operator+=(const String& other) { concat(other); return *this; }
+    String& operator+=(const char* text) { concat(text); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+
+    bool operator==(const String& other) const { return strcmp(c_str(), other.c_str()) == 0; }
+    bool operator==(const char* text) const { return strcmp(c_str(), text ? text : "") == 0; }
+    bool operator!=(const String& other) const { return !(*this == other); }
+    bool operator!=(const char* text) const { return !(*this == text); }
+    bool operator<(const String& other) const { return strcmp(c_str(), other.c_str()) < 0; }
+    bool equals(const String& other) const { return *this == other; }
+
+    const char* c_str() const { return buffer_ ? buffer_ : ""; }
+    unsigned length() const { return length_; }
+    bool isEmpty() const { return length_ == 0; }
+    char operator[](unsigned i) const { return i < length_ ? buffer_[i] : '\0'; }
+    char charAt(unsigned i) const { return (*this)[i]; }
+    void clear() { length_ = 0; if (buffer_) buffer_[0] = '\0'; }
+    void remove(unsigned index) { if (index < length_) { length_ = index; buffer_[length_] = '\0'; } }
+    int indexOf(char c) const {
+        const char* hit = strchr(c_str(), c);
+        return hit ? (int)(hit - c_str()) : -1;
+    }
+    int toInt() const { return atoi(c_str()); }
+    float toFloat() const { return (float)atof(c_str()); }
+
+private:
+    void assign(const char* text, unsigned n) {
+        if (!reserve(n)) return;
+        if (n) memmove(buffer_, text, n);
+        length_ = n;
+        buffer_[length_] = '\0';
+    }
+
+    template<typename... Args>
+    void format(const char* pattern, Args... args) {
+        char tmp[48];
+        int n = snprintf(tmp, sizeof(tmp), pattern, args...);
+        assign(tmp, n < 0 ? 0 : (unsigned)n);
+    }
+
+    char* buffer_;
+    unsigned length_;
+    unsigned capacity_;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t n) {
+        size_t written = 0;
+        while (n--) written += write(*data++);
+        return written;
+    }
+    size_t write(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+    size_t write(const char* text, size_t n) { return write(reinterpret_cast<const uint8_t*>(text), n); }
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const __FlashStringHelper* text) { return write(reinterpret_cast<const char*>(text)); }
+    size_t print(const String& text) { return write(text.c_str(), text.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printFormatted("%d", value); }
+    size_t print(unsigned value) { return printFormatted("%u", value); }
+    size_t print(long value) { return printFormatted("%ld", value); }
+    size_t print(unsigned long value) { return printFormatted("%lu", value); }
+    size_t print(double value, int decimals = 2) { return printFormatted("%.*f", decimals, value); }
+
+    size_t println() { return write("\r\n"); }
+    template<typename T>
+    size_t println(const T& value) { return print(value) + println(); }
+    size_t println(double value, int decimals) { return print(value, decimals) + println(); }
+    void flush() {}
+
+private:
+    template<typename... Args>
+    size_t printFormatted(const char* pattern, Args... args) {
+        char tmp[48];
+        int n = snprintf(tmp, sizeof(tmp), pattern, args...);
+        return n > 0 ? write(tmp, (size_t)n) : 0;
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(char* buffer, size_t n) {
+        size_t count = 0;
+        int c;
+        while (count < n && (c = read()) >= 0) buffer[count++] = (char)c;
+        return count;
+    }
+    size_t readBytes(uint8_t* buffer, size_t n) { return readBytes(reinterpret_cast<char*>(buffer), n); }
+    void setTimeout(unsigned long) {}
+};
+
+class HostSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* data, size_t n) override { return fwrite(data, 1, n, stdout); }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    explicit operator bool() const { return true; }
+};
+
+// Each benchmark binary is a single translation unit
+static HostSerial Serial;
+
+#endif // STRUCTA_BENCH_ARDUINO_H
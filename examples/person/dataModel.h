@@ -1,7 +1,7 @@
 #ifndef DATA_MODEL_H
 #define DATA_MODEL_H
 
-#include "structa.h"
+#include <structa.h>
 
 #define fields(field)   \
   field(String,id)      \
@@ -1,5 +1,5 @@
 #include <Arduino.h>
-#include "structa.h"
+#include <structa.h>
 
 #include "dataModel.h"
 
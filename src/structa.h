@@ -5,6 +5,58 @@
 #define STRUCTA_H
 
 #include <ArduinoJson.h>
+#include <utility>
+#include <stddef.h>
+#include <math.h>
+#include <limits.h>
+
+// ======================================================
+// Flash Strings and Feature Switches
+// ======================================================
+// STRUCTA_USE_PROGMEM keeps field names, rule tables and diagnostic text in
+// flash on AVR and ESP8266, where string literals are otherwise copied to RAM
+// at startup. Keys are then written with ArduinoJson's __FlashStringHelper
+// overloads (which copy them into the document pool, already counted in
+// jsonCapacity) and matched with strcmp_P.
+//
+// The optional subsystems can each be compiled out; calls into them still
+// build against empty stubs:
+//   STRUCTA_INTROSPECTION 0   diagnostic printers and guides
+//   STRUCTA_VALIDATION 0      META field rules, validator lists, error lists;
+//                             validate() and validateSelf() always succeed
+//   STRUCTA_MEMORY_TRACKER 0  MemoryTracker counters and per-type statistics
+#ifndef STRUCTA_USE_PROGMEM
+#define STRUCTA_USE_PROGMEM 0
+#endif
+#ifndef STRUCTA_INTROSPECTION
+#define STRUCTA_INTROSPECTION 1
+#endif
+#ifndef STRUCTA_VALIDATION
+#define STRUCTA_VALIDATION 1
+#endif
+#ifndef STRUCTA_MEMORY_TRACKER
+#define STRUCTA_MEMORY_TRACKER 1
+#endif
+
+#if STRUCTA_USE_PROGMEM
+typedef const __FlashStringHelper* StructaKeyText;
+#define STRUCTA_KEY(name) F(name)
+#define STRUCTA_KEY_EQUALS(key, name) (strcmp_P((key), PSTR(name)) == 0)
+#define STRUCTA_KEY_SIZE(name) sizeof(name)   // pool copy of a flash key
+#define STRUCTA_TEXT(text) F(text)
+#define STRUCTA_PROGMEM PROGMEM
+#define STRUCTA_FLASH(p) reinterpret_cast<const __FlashStringHelper*>(p)   // printable flash pointer
+#define STRUCTA_NAME_EQUALS(key, stored) (strcmp_P((key), (stored)) == 0)
+#else
+typedef const char* StructaKeyText;
+#define STRUCTA_KEY(name) name
+#define STRUCTA_KEY_EQUALS(key, name) (strcmp((key), (name)) == 0)
+#define STRUCTA_KEY_SIZE(name) 0              // literal keys are linked, not copied
+#define STRUCTA_TEXT(text) text
+#define STRUCTA_PROGMEM
+#define STRUCTA_FLASH(p) (p)
+#define STRUCTA_NAME_EQUALS(key, stored) (strcmp((key), (stored)) == 0)
+#endif
 
 // ======================================================
 // Error Handling
@@ -60,6 +112,13 @@ struct SerializationResult {
         return result;
     }
     
+    static SerializationResult<T> Success(T&& value) {
+        SerializationResult<T> result;
+        result.success = true;
+        result.data = std::move(value);
+        return result;
+    }
+    
     static SerializationResult<T> Failure(SerializationError code, const String& msg, const String& path = "") {
         SerializationResult<T> result;
         result.success = false;
@@ -68,34 +127,62 @@ struct SerializationResult {
     }
     
     operator bool() const { return success; }
+    
+    // Take the outcome of a status-only call (e.g. deserializeInto) without copying data
+    void setStatus(const SerializationResult<void>& status);
+};
+
+template<>
+struct SerializationResult<void> {
+    bool success;
+    ErrorInfo error;
+    
+    SerializationResult() : success(false) {}
+    
+    static SerializationResult<void> Success() {
+        SerializationResult<void> result;
+        result.success = true;
+        return result;
+    }
+    
+    static SerializationResult<void> Failure(SerializationError code, const String& msg, const String& path = "") {
+        SerializationResult<void> result;
+        result.success = false;
+        result.error = ErrorInfo(code, msg, path);
+        return result;
+    }
+    
+    operator bool() const { return success; }
 };
 
+template<typename T>
+void SerializationResult<T>::setStatus(const SerializationResult<void>& status) {
+    success = status.success;
+    error = status.error;
+}
+
 // ======================================================
 // Validation Support (NEW)
 // ======================================================
+#if STRUCTA_VALIDATION
 
-// Validator interface - all validators inherit from this
-struct ValidatorBase {
-    virtual bool validate(const String& fieldName, const String& value, String& errorMsg) const { return true; }
-    virtual bool validate(const String& fieldName, int value, String& errorMsg) const { return true; }
-    virtual bool validate(const String& fieldName, float value, String& errorMsg) const { return true; }
-    virtual bool validate(const String& fieldName, double value, String& errorMsg) const { return true; }
-    virtual bool validate(const String& fieldName, bool value, String& errorMsg) const { return true; }
-    virtual ~ValidatorBase() {}
-};
+// Validators are literal types with non-virtual checks. They are never stored
+// in a struct instance: each check builds its validator from a constexpr
+// factory, so limits fold into the generated code.
 
 // Range validator for numeric types
 template<typename T>
-struct RangeValidator : public ValidatorBase {
+struct RangeValidator {
     T minVal;
     T maxVal;
     bool hasMin;
     bool hasMax;
     
-    RangeValidator() : hasMin(false), hasMax(false) {}
-    RangeValidator(T min, T max) : minVal(min), maxVal(max), hasMin(true), hasMax(true) {}
+    constexpr RangeValidator() : minVal(), maxVal(), hasMin(false), hasMax(false) {}
+    constexpr RangeValidator(T min, T max) : minVal(min), maxVal(max), hasMin(true), hasMax(true) {}
     
-    bool validate(const String& fieldName, T value, String& errorMsg) const {
+    template<typename V>
+    bool validate(const char* fieldName, V value, String& errorMsg) const {
         if (hasMin && value < minVal) {
             errorMsg = "Value " + String(value) + " is below minimum " + String(minVal);
             return false;
@@ -109,33 +196,27 @@ struct RangeValidator : public ValidatorBase {
 };
 
 // String length validator
-struct StringLengthValidator : public ValidatorBase {
+struct StringLengthValidator {
     size_t minLen;
     size_t maxLen;
     bool hasMin;
     bool hasMax;
     
-    StringLengthValidator() : hasMin(false), hasMax(false) {}
-    StringLengthValidator(size_t min, size_t max) : minLen(min), maxLen(max), hasMin(true), hasMax(true) {}
-    StringLengthValidator(size_t exactLen) : minLen(exactLen), maxLen(exactLen), hasMin(true), hasMax(true) {}
+    constexpr StringLengthValidator() : minLen(0), maxLen(0), hasMin(false), hasMax(false) {}
+    constexpr StringLengthValidator(size_t min, size_t max) : minLen(min), maxLen(max), hasMin(true), hasMax(true) {}
+    constexpr StringLengthValidator(size_t exactLen) : minLen(exactLen), maxLen(exactLen), hasMin(true), hasMax(true) {}
+    constexpr StringLengthValidator(size_t min, size_t max, bool useMin, bool useMax)
+        : minLen(min), maxLen(max), hasMin(useMin), hasMax(useMax) {}
     
-    static StringLengthValidator minLength(size_t min) {
-        StringLengthValidator v;
-        v.minLen = min;
-        v.hasMin = true;
-        v.hasMax = false;
-        return v;
+    static constexpr StringLengthValidator minLength(size_t min) {
+        return StringLengthValidator(min, 0, true, false);
     }
     
-    static StringLengthValidator maxLength(size_t max) {
-        StringLengthValidator v;
-        v.maxLen = max;
-        v.hasMin = false;
-        v.hasMax = true;
-        return v;
+    static constexpr StringLengthValidator maxLength(size_t max) {
+        return StringLengthValidator(0, max, false, true);
     }
     
-    bool validate(const String& fieldName, const String& value, String& errorMsg) const {
+    bool validate(const char* fieldName, const String& value, String& errorMsg) const {
         if (hasMin && value.length() < minLen) {
             errorMsg = "String length " + String(value.length()) + " is below minimum " + String(minLen);
             return false;
@@ -149,8 +230,10 @@ struct StringLengthValidator : public ValidatorBase {
 };
 
 // Required field validator
-struct RequiredValidator : public ValidatorBase {
-    bool validate(const String& fieldName, const String& value, String& errorMsg) const {
+struct RequiredValidator {
+    constexpr RequiredValidator() {}
+    
+    bool validate(const char* fieldName, const String& value, String& errorMsg) const {
         if (value.length() == 0) {
             errorMsg = "Field is required but empty";
             return false;
@@ -158,34 +241,23 @@ struct RequiredValidator : public ValidatorBase {
         return true;
     }
     
-    bool validate(const String& fieldName, int value, String& errorMsg) const {
-        // For numeric types, we could consider 0 as empty or not - this is configurable
-        return true; // By default, any numeric value is considered valid for required
-    }
-    
-    bool validate(const String& fieldName, float value, String& errorMsg) const {
-        return true; // By default, any numeric value is considered valid for required
-    }
-    
-    bool validate(const String& fieldName, double value, String& errorMsg) const {
-        return true; // By default, any numeric value is considered valid for required
-    }
-    
-    bool validate(const String& fieldName, bool value, String& errorMsg) const {
-        return true; // Boolean values are always considered valid for required
+    // Numeric and boolean values are always considered present
+    template<typename V>
+    bool validate(const char* fieldName, V value, String& errorMsg) const {
+        return true;
     }
 };
 
 // Custom function validator
 template<typename T>
-struct CustomValidator : public ValidatorBase {
+struct CustomValidator {
     bool (*validatorFunc)(T);
-    String customErrorMsg;
+    const char* customErrorMsg;
     
-    CustomValidator(bool (*func)(T), const String& errorMessage = "Custom validation failed")
+    constexpr CustomValidator(bool (*func)(T), const char* errorMessage = "Custom validation failed")
         : validatorFunc(func), customErrorMsg(errorMessage) {}
     
-    bool validate(const String& fieldName, T value, String& errorMsg) const {
+    bool validate(const char* fieldName, T value, String& errorMsg) const {
         if (!validatorFunc(value)) {
             errorMsg = customErrorMsg;
             return false;
@@ -194,34 +266,370 @@ struct CustomValidator : public ValidatorBase {
     }
 };
 
+#endif // STRUCTA_VALIDATION
+
 // ======================================================
 // Memory Tracking
 // ======================================================
+// Current/peak figures are the capacity of the documents alive right now.
+// Each generated operation also records the bytes its document really used
+// (memoryUsage()), the bytes it produced, and on ESP32/ESP8266 the free heap
+// and largest free block while it ran.
+#if defined(ESP32) || defined(ESP8266)
+#define STRUCTA_HAS_HEAP_INFO 1
+#else
+#define STRUCTA_HAS_HEAP_INFO 0
+#endif
+
+// Thread safety: the generated methods keep all working state (documents,
+// results, output) on the caller's stack and share nothing but the tracker
+// counters, so any two calls may run concurrently on different tasks or
+// cores. The counters are updated under a lock: a critical section on ESP32
+// (both cores), nothing on single-core targets. Define STRUCTA_LOCK() and
+// STRUCTA_UNLOCK() to supply another lock.
+// The exception is each type's memoryStats() and jsonFilter(), function-local
+// statics built on first use. Compilers guard that construction unless built
+// with -fno-threadsafe-statics (the AVR and ESP8266 cores), where the first
+// call per type must finish before a second task or an ISR can make one:
+// call both once from setup() for types used concurrently there.
+#ifndef STRUCTA_THREAD_SAFE
+#if defined(ESP32)
+#define STRUCTA_THREAD_SAFE 1
+#else
+#define STRUCTA_THREAD_SAFE 0
+#endif
+#endif
+
+// Per-task figures for FreeRTOS builds: the first STRUCTA_MAX_TRACKED_TASKS
+// tasks that use the tracker get their own counters
+#ifndef STRUCTA_TRACK_TASKS
+#define STRUCTA_TRACK_TASKS 0
+#endif
+#ifndef STRUCTA_MAX_TRACKED_TASKS
+#define STRUCTA_MAX_TRACKED_TASKS 4
+#endif
+
+// Scoped lock guarding Structa's shared state (tracker counters, document pools)
+struct StructaLock {
+    StructaLock() {
+#if defined(STRUCTA_LOCK)
+        STRUCTA_LOCK();
+#elif STRUCTA_THREAD_SAFE && defined(ESP32)
+        portENTER_CRITICAL(&mux);
+#endif
+    }
+    ~StructaLock() {
+#if defined(STRUCTA_UNLOCK)
+        STRUCTA_UNLOCK();
+#elif STRUCTA_THREAD_SAFE && defined(ESP32)
+        portEXIT_CRITICAL(&mux);
+#endif
+    }
+
+#if STRUCTA_THREAD_SAFE && defined(ESP32) && !defined(STRUCTA_LOCK)
+    static portMUX_TYPE mux;
+#endif
+};
+
 class MemoryTracker {
+public:
+    enum Operation { SERIALIZE, DESERIALIZE, BATCH, DIAGNOSTIC, OPERATION_COUNT };
+    enum QueueEvent { QUEUE_PUBLISHED, QUEUE_DROPPED, QUEUE_ENCODED, QUEUE_FAILED, QUEUE_SENT, QUEUE_STALLED, QUEUE_EVENT_COUNT };
+
+#if STRUCTA_MEMORY_TRACKER
+
+    // Per-struct figures; one instance per generated type, chained for printStats()
+    struct TypeStats {
+        const char* name;
+        size_t capacity;                       // jsonCapacity the type's documents are sized for
+        size_t operations[OPERATION_COUNT];
+        size_t peakDocumentUsage;              // largest memoryUsage() seen
+        size_t peakOutput;                     // largest single output in bytes
+        TypeStats* next;
+
+        TypeStats(const char* typeName, size_t documentCapacity)
+            : name(typeName), capacity(documentCapacity), peakDocumentUsage(0), peakOutput(0), next(nullptr) {
+            for (size_t i = 0; i < OPERATION_COUNT; ++i) operations[i] = 0;
+            StructaLock lock;
+            next = typeList;
+            typeList = this;
+        }
+    };
+
+    // Per-pipeline backpressure figures, chained for printStats()
+    struct QueueStats {
+        const char* name;
+        size_t depth;                          // snapshots the queue holds
+        size_t peakQueued;                     // most snapshots waiting at once
+        size_t events[QUEUE_EVENT_COUNT];      // FAILED: did not fit or was cut short by the sink;
+                                               // STALLED: encoder found both buffers unsent
+        QueueStats* next;
+
+        QueueStats(const char* queueName, size_t queueDepth) : name(queueName), depth(queueDepth), peakQueued(0), next(nullptr) {
+            for (size_t i = 0; i < QUEUE_EVENT_COUNT; ++i) events[i] = 0;
+            StructaLock lock;
+            next = queueList;
+            queueList = this;
+        }
+    };
+
+#if STRUCTA_TRACK_TASKS
+    struct TaskStats {
+        TaskHandle_t task;
+        size_t operations;
+        size_t currentUsage;
+        size_t peakUsage;
+    };
+#endif
+
+    // Tracks one operation on a live document; figures are recorded on destruction
+    class Scope {
+    public:
+        Scope(TypeStats& stats, Operation op, const JsonDocument& doc)
+            : stats_(stats), op_(op), doc_(doc), capacity_(doc.capacity()), used_(0), output_(0) {
+            recordAllocation(capacity_);
+        }
+
+        ~Scope() {
+            sample();
+            recordOperation(stats_, op_, used_, output_);
+            recordDeallocation(capacity_);
+        }
+
+        // Call before a document is reused so each fill is counted
+        void sample() {
+            size_t used = doc_.memoryUsage();
+            if (used > used_) used_ = used;
+        }
+
+        void output(size_t bytes) { output_ += bytes; }
+
+    private:
+        TypeStats& stats_;
+        Operation op_;
+        const JsonDocument& doc_;
+        size_t capacity_;
+        size_t used_;
+        size_t output_;
+    };
+
 private:
     static size_t totalAllocated;
     static size_t peakUsage;
+    static size_t peakDocumentUsage;
+    static size_t totalOutput;
+    static size_t operationCounts[OPERATION_COUNT];
+    static size_t minFreeHeap;
+    static size_t minLargestBlock;
+    static TypeStats* typeList;
+    static QueueStats* queueList;
+#if STRUCTA_TRACK_TASKS
+    static TaskStats taskStats[STRUCTA_MAX_TRACKED_TASKS];
+
+    // Slot for the running task, claimed on first use; nullptr once all are taken.
+    // Called with the lock held.
+    static TaskStats* currentTask() {
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        for (size_t i = 0; i < STRUCTA_MAX_TRACKED_TASKS; ++i) {
+            if (taskStats[i].task == self) return &taskStats[i];
+            if (taskStats[i].task == nullptr) {
+                taskStats[i].task = self;
+                return &taskStats[i];
+            }
+        }
+        return nullptr;
+    }
+#endif
     
 public:
     static void recordAllocation(size_t size) {
+        StructaLock lock;
         totalAllocated += size;
         if(totalAllocated > peakUsage) peakUsage = totalAllocated;
+#if STRUCTA_TRACK_TASKS
+        if (TaskStats* task = currentTask()) {
+            task->currentUsage += size;
+            if (task->currentUsage > task->peakUsage) task->peakUsage = task->currentUsage;
+        }
+#endif
     }
     
     static void recordDeallocation(size_t size) {
+        StructaLock lock;
         if(totalAllocated >= size) totalAllocated -= size;
+#if STRUCTA_TRACK_TASKS
+        if (TaskStats* task = currentTask()) {
+            if (task->currentUsage >= size) task->currentUsage -= size;
+        }
+#endif
+    }
+
+    static void recordOperation(TypeStats& stats, Operation op, size_t documentUsage, size_t outputBytes) {
+#if STRUCTA_HAS_HEAP_INFO
+        // Heap queries take their own locks, so read them before entering ours
+        size_t heap = freeHeap();
+        size_t block = largestFreeBlock();
+#endif
+        StructaLock lock;
+        ++operationCounts[op];
+        ++stats.operations[op];
+        if (documentUsage > peakDocumentUsage) peakDocumentUsage = documentUsage;
+        if (documentUsage > stats.peakDocumentUsage) stats.peakDocumentUsage = documentUsage;
+        totalOutput += outputBytes;
+        if (outputBytes > stats.peakOutput) stats.peakOutput = outputBytes;
+#if STRUCTA_HAS_HEAP_INFO
+        if (minFreeHeap == 0 || heap < minFreeHeap) minFreeHeap = heap;
+        if (minLargestBlock == 0 || block < minLargestBlock) minLargestBlock = block;
+#endif
+#if STRUCTA_TRACK_TASKS
+        if (TaskStats* task = currentTask()) ++task->operations;
+#endif
+    }
+
+    static void recordQueue(QueueStats& stats, QueueEvent event) {
+        StructaLock lock;
+        ++stats.events[event];
+    }
+
+    // Producer-side counts since the last call and the queue length the
+    // consumer found, folded in from the consumer so publishing takes no lock
+    static void recordPublished(QueueStats& stats, size_t published, size_t dropped, size_t queued) {
+        StructaLock lock;
+        stats.events[QUEUE_PUBLISHED] += published;
+        stats.events[QUEUE_DROPPED] += dropped;
+        if (queued > stats.peakQueued) stats.peakQueued = queued;
     }
     
     static size_t getCurrentUsage() { return totalAllocated; }
     static size_t getPeakUsage() { return peakUsage; }
+    static size_t getPeakDocumentUsage() { return peakDocumentUsage; }
+    static size_t getTotalOutput() { return totalOutput; }
+    static size_t getOperationCount(Operation op) { return operationCounts[op]; }
+    static const TypeStats* getTypeStats() { return typeList; }
+    static const QueueStats* getQueueStats() { return queueList; }
+
+    static size_t getMinFreeHeap() { return minFreeHeap; }
+    static size_t getMinLargestBlock() { return minLargestBlock; }
+
+    static void reset() {
+        StructaLock lock;
+        peakUsage = totalAllocated;
+        peakDocumentUsage = 0;
+        totalOutput = 0;
+        minFreeHeap = 0;
+        minLargestBlock = 0;
+        for (size_t i = 0; i < OPERATION_COUNT; ++i) operationCounts[i] = 0;
+        for (TypeStats* t = typeList; t; t = t->next) {
+            for (size_t i = 0; i < OPERATION_COUNT; ++i) t->operations[i] = 0;
+            t->peakDocumentUsage = 0;
+            t->peakOutput = 0;
+        }
+        for (QueueStats* q = queueList; q; q = q->next) {
+            for (size_t i = 0; i < QUEUE_EVENT_COUNT; ++i) q->events[i] = 0;
+            q->peakQueued = 0;
+        }
+#if STRUCTA_TRACK_TASKS
+        for (size_t i = 0; i < STRUCTA_MAX_TRACKED_TASKS; ++i) {
+            taskStats[i].operations = 0;
+            taskStats[i].peakUsage = taskStats[i].currentUsage;
+        }
+#endif
+    }
+
+#if STRUCTA_TRACK_TASKS
+    static const TaskStats* getTaskStats() { return taskStats; }
+#endif
     
+    // Reads the counters without the lock; figures may be mid-update under load
     static void printStats() {
         Serial.println("Memory - Current: " + String(totalAllocated) + " bytes, Peak: " + String(peakUsage) + " bytes");
+        Serial.println("Documents - Peak used: " + String(peakDocumentUsage) + " bytes, Output: " + String(totalOutput) + " bytes");
+        Serial.println("Operations - Serialize: " + String(operationCounts[SERIALIZE]) +
+                       ", Deserialize: " + String(operationCounts[DESERIALIZE]) +
+                       ", Batch: " + String(operationCounts[BATCH]) +
+                       ", Diagnostic: " + String(operationCounts[DIAGNOSTIC]));
+#if STRUCTA_HAS_HEAP_INFO
+        Serial.println("Heap - Free: " + String(freeHeap()) + " bytes (min " + String(minFreeHeap) +
+                       "), Largest block: " + String(largestFreeBlock()) + " bytes (min " + String(minLargestBlock) + ")");
+#endif
+        for (TypeStats* t = typeList; t; t = t->next) {
+            Serial.println("  " + String(t->name) + ": used " + String(t->peakDocumentUsage) + "/" + String(t->capacity) +
+                           " bytes, out " + String(t->peakOutput) + " bytes, ops " +
+                           String(t->operations[SERIALIZE]) + "/" + String(t->operations[DESERIALIZE]) + "/" +
+                           String(t->operations[BATCH]) + "/" + String(t->operations[DIAGNOSTIC]));
+        }
+        for (QueueStats* q = queueList; q; q = q->next) {
+            Serial.println("  queue " + String(q->name) + ": peak " + String(q->peakQueued) + "/" + String(q->depth) +
+                           ", published " + String(q->events[QUEUE_PUBLISHED]) + ", dropped " + String(q->events[QUEUE_DROPPED]) +
+                           ", encoded " + String(q->events[QUEUE_ENCODED]) + ", failed " + String(q->events[QUEUE_FAILED]) +
+                           ", sent " + String(q->events[QUEUE_SENT]) + ", stalled " + String(q->events[QUEUE_STALLED]));
+        }
+#if STRUCTA_TRACK_TASKS
+        for (size_t i = 0; i < STRUCTA_MAX_TRACKED_TASKS; ++i) {
+            const TaskStats& task = taskStats[i];
+            if (task.task == nullptr) continue;
+            Serial.println("  task " + String(pcTaskGetName(task.task)) + ": " + String(task.operations) +
+                           " ops, current " + String(task.currentUsage) + " bytes, peak " + String(task.peakUsage) + " bytes");
+        }
+#endif
     }
+#else
+    // Tracking compiled out: same calls, nothing recorded, every figure 0.
+    // Per-type, per-queue and per-task listings are not available.
+    struct TypeStats {
+        constexpr TypeStats(const char*, size_t) {}
+    };
+
+    struct QueueStats {
+        constexpr QueueStats(const char*, size_t) {}
+    };
+
+    class Scope {
+    public:
+        Scope(TypeStats&, Operation, const JsonDocument&) {}
+        void sample() {}
+        void output(size_t) {}
+    };
+
+    static void recordAllocation(size_t) {}
+    static void recordDeallocation(size_t) {}
+    static void recordOperation(TypeStats&, Operation, size_t, size_t) {}
+    static void recordQueue(QueueStats&, QueueEvent) {}
+    static void recordPublished(QueueStats&, size_t, size_t, size_t) {}
+    static size_t getCurrentUsage() { return 0; }
+    static size_t getPeakUsage() { return 0; }
+    static size_t getPeakDocumentUsage() { return 0; }
+    static size_t getTotalOutput() { return 0; }
+    static size_t getOperationCount(Operation) { return 0; }
+    static size_t getMinFreeHeap() { return 0; }
+    static size_t getMinLargestBlock() { return 0; }
+    static void reset() {}
+    static void printStats() {}
+#endif // STRUCTA_MEMORY_TRACKER
+
+    // Heap figures; 0 on targets without heap introspection
+    static size_t freeHeap() {
+#if defined(ESP32) || defined(ESP8266)
+        return ESP.getFreeHeap();
+#else
+        return 0;
+#endif
+    }
+
+    static size_t largestFreeBlock() {
+#if defined(ESP32)
+        return ESP.getMaxAllocHeap();
+#elif defined(ESP8266)
+        return ESP.getMaxFreeBlockSize();
+#else
+        return 0;
+#endif
+    }
+#if STRUCTA_INTROSPECTION
     static void printExistingStructDefinition(const String& structName, const String& fieldsJson) {
-        Serial.println("=== Existing Struct Definition ===");
+        Serial.println(STRUCTA_TEXT("=== Existing Struct Definition ==="));
         Serial.println("Struct Name: " + structName);
-        Serial.println("Current JSON Structure:");
+        Serial.println(STRUCTA_TEXT("Current JSON Structure:"));
         Serial.println(fieldsJson);
         Serial.println();
         
@@ -229,7 +637,7 @@ public:
         DynamicJsonDocument doc(512);
         DeserializationError err = deserializeJson(doc, fieldsJson);
         if (!err) {
-            Serial.println("Detected Fields:");
+            Serial.println(STRUCTA_TEXT("Detected Fields:"));
             JsonObject obj = doc.as<JsonObject>();
             for (JsonPair kv : obj) {
                 String fieldName = kv.key().c_str();
@@ -251,98 +659,117 @@ public:
                 Serial.println("  - " + fieldName + " (" + fieldType + ")");
             }
         }
-        Serial.println("===================================");
+        Serial.println(STRUCTA_TEXT("==================================="));
     }
     
     static void showMacroWritingGuide() {
-        Serial.println("=== How to Write Struct Macros ===");
-        Serial.println();
-        Serial.println("Step 1: Define your fields macro");
-        Serial.println("Pattern: #define STRUCT_NAME_FIELDS(field) \\");
-        Serial.println("    field(Type, fieldName) \\");
-        Serial.println("    field(Type, fieldName) \\");
-        Serial.println("    // ... more fields");
-        Serial.println();
-        Serial.println("Step 2: Create the struct");
-        Serial.println("DEFINE_STRUCTA(StructName, STRUCT_NAME_FIELDS)");
-        Serial.println();
-        Serial.println("=== Example 1: Simple Person Struct ===");
-        Serial.println("#define PERSON_FIELDS(field) \\");
-        Serial.println("    field(String, name) \\");
-        Serial.println("    field(int, age) \\");
-        Serial.println("    field(float, height)");
-        Serial.println();
-        Serial.println("DEFINE_STRUCTA(Person, PERSON_FIELDS)");
-        Serial.println();
-        Serial.println("=== Example 2: IoT Sensor Data ===");
-        Serial.println("#define SENSOR_FIELDS(field) \\");
-        Serial.println("    field(String, deviceId) \\");
-        Serial.println("    field(float, temperature) \\");
-        Serial.println("    field(float, humidity) \\");
-        Serial.println("    field(int, batteryLevel) \\");
-        Serial.println("    field(unsigned long, timestamp)");
-        Serial.println();
-        Serial.println("DEFINE_STRUCTA(SensorReading, SENSOR_FIELDS)");
-        Serial.println();
-        Serial.println("=== Example 3: WITH VALIDATION (NEW!) ===");
-        Serial.println("#define SENSOR_FIELDS_V(field) \\");
-        Serial.println("    field(String, deviceId) \\");
-        Serial.println("    field(float, temperature) \\");
-        Serial.println("    field(float, humidity) \\");
-        Serial.println("    field(int, batteryLevel)");
-        Serial.println();
-        Serial.println("#define SENSOR_VALIDATORS(v) \\");
-        Serial.println("    v(temperature, makeRangeValidatorFloat(-40, 85)) \\");
-        Serial.println("    v(humidity, makeRangeValidatorFloat(0, 100)) \\");
-        Serial.println("    v(batteryLevel, makeRangeValidatorInt(0, 100)) \\");
-        Serial.println("    v(deviceId, makeRequiredValidator())");
-        Serial.println();
-        Serial.println("DEFINE_STRUCTA_WITH_VALIDATION(Sensor, SENSOR_FIELDS_V, SENSOR_VALIDATORS)");
-        Serial.println();
-        Serial.println("=== Example 4: Nested Structures ===");
-        Serial.println("// First define the nested struct");
-        Serial.println("#define GPS_FIELDS(field) \\");
-        Serial.println("    field(float, latitude) \\");
-        Serial.println("    field(float, longitude) \\");
-        Serial.println("    field(float, altitude)");
-        Serial.println();
-        Serial.println("DEFINE_STRUCTA(GPSCoordinate, GPS_FIELDS)");
-        Serial.println();
-        Serial.println("// Then use it in parent struct");
-        Serial.println("#define LOCATION_FIELDS(field) \\");
-        Serial.println("    field(String, locationName) \\");
-        Serial.println("    field(GPSCoordinate, coordinates) \\");
-        Serial.println("    field(String, description)");
-        Serial.println();
-        Serial.println("DEFINE_STRUCTA(Location, LOCATION_FIELDS)");
-        Serial.println();
-        Serial.println("=== Supported Types ===");
-        Serial.println("Primitives: int, float, double, bool, char");
-        Serial.println("Strings: String, const char*");
-        Serial.println("Time: unsigned long (for timestamps)");
-        Serial.println("Nested: Any struct created with DEFINE_STRUCTA");
-        Serial.println();
-        Serial.println("=== Validation Types (NEW!) ===");
-        Serial.println("RangeValidator<T>(min, max) - For numeric types");
-        Serial.println("StringLengthValidator(min, max) - For strings");
-        Serial.println("StringLengthValidator::minLength(min) - Minimum length only");
-        Serial.println("StringLengthValidator::maxLength(max) - Maximum length only");
-        Serial.println("RequiredValidator() - Field cannot be empty");
-        Serial.println("CustomValidator<T>(func, errorMsg) - Custom validation function");
-        Serial.println();
-        Serial.println("=== Important Notes ===");
-        Serial.println("1. Always end field lines with backslash (\\) except the last");
-        Serial.println("2. Use consistent naming conventions");
-        Serial.println("3. Define nested structs before parent structs");
-        Serial.println("4. Field names become JSON keys automatically");
-        Serial.println("5. Validation is optional - use DEFINE_STRUCTA or DEFINE_STRUCTA_WITH_VALIDATION");
-        Serial.println("6. Validation occurs automatically during deserializeWithResult()");
-        Serial.println("=====================================");
+        Serial.println(STRUCTA_TEXT("=== How to Write Struct Macros ==="));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("Step 1: Define your fields macro"));
+        Serial.println(STRUCTA_TEXT("Pattern: #define STRUCT_NAME_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(Type, fieldName) \\"));
+        Serial.println(STRUCTA_TEXT("    field(Type, fieldName) \\"));
+        Serial.println(STRUCTA_TEXT("    // ... more fields"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("Step 2: Create the struct"));
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA(StructName, STRUCT_NAME_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Example 1: Simple Person Struct ==="));
+        Serial.println(STRUCTA_TEXT("#define PERSON_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(String, name) \\"));
+        Serial.println(STRUCTA_TEXT("    field(int, age) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, height)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA(Person, PERSON_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Example 2: IoT Sensor Data ==="));
+        Serial.println(STRUCTA_TEXT("#define SENSOR_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(String, deviceId) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, temperature) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, humidity) \\"));
+        Serial.println(STRUCTA_TEXT("    field(int, batteryLevel) \\"));
+        Serial.println(STRUCTA_TEXT("    field(unsigned long, timestamp)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA(SensorReading, SENSOR_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Example 3: WITH VALIDATION (NEW!) ==="));
+        Serial.println(STRUCTA_TEXT("#define SENSOR_FIELDS_V(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(String, deviceId) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, temperature) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, humidity) \\"));
+        Serial.println(STRUCTA_TEXT("    field(int, batteryLevel)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("#define SENSOR_VALIDATORS(v) \\"));
+        Serial.println(STRUCTA_TEXT("    v(temperature, makeRangeValidatorFloat(-40, 85)) \\"));
+        Serial.println(STRUCTA_TEXT("    v(humidity, makeRangeValidatorFloat(0, 100)) \\"));
+        Serial.println(STRUCTA_TEXT("    v(batteryLevel, makeRangeValidatorInt(0, 100)) \\"));
+        Serial.println(STRUCTA_TEXT("    v(deviceId, makeRequiredValidator())"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA_WITH_VALIDATION(Sensor, SENSOR_FIELDS_V, SENSOR_VALIDATORS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Example 4: Nested Structures ==="));
+        Serial.println(STRUCTA_TEXT("// First define the nested struct"));
+        Serial.println(STRUCTA_TEXT("#define GPS_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, latitude) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, longitude) \\"));
+        Serial.println(STRUCTA_TEXT("    field(float, altitude)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA(GPSCoordinate, GPS_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("// Then use it in parent struct"));
+        Serial.println(STRUCTA_TEXT("#define LOCATION_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("    field(String, locationName) \\"));
+        Serial.println(STRUCTA_TEXT("    field(GPSCoordinate, coordinates) \\"));
+        Serial.println(STRUCTA_TEXT("    field(String, description)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("DEFINE_STRUCTA(Location, LOCATION_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Supported Types ==="));
+        Serial.println(STRUCTA_TEXT("Primitives: int, float, double, bool, char"));
+        Serial.println(STRUCTA_TEXT("Strings: String, const char*"));
+        Serial.println(STRUCTA_TEXT("Time: unsigned long (for timestamps)"));
+        Serial.println(STRUCTA_TEXT("Nested: Any struct created with DEFINE_STRUCTA"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Validation Types (NEW!) ==="));
+        Serial.println(STRUCTA_TEXT("RangeValidator<T>(min, max) - For numeric types"));
+        Serial.println(STRUCTA_TEXT("StringLengthValidator(min, max) - For strings"));
+        Serial.println(STRUCTA_TEXT("StringLengthValidator::minLength(min) - Minimum length only"));
+        Serial.println(STRUCTA_TEXT("StringLengthValidator::maxLength(max) - Maximum length only"));
+        Serial.println(STRUCTA_TEXT("RequiredValidator() - Field cannot be empty"));
+        Serial.println(STRUCTA_TEXT("CustomValidator<T>(func, errorMsg) - Custom validation function"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("=== Important Notes ==="));
+        Serial.println(STRUCTA_TEXT("1. Always end field lines with backslash (\\) except the last"));
+        Serial.println(STRUCTA_TEXT("2. Use consistent naming conventions"));
+        Serial.println(STRUCTA_TEXT("3. Define nested structs before parent structs"));
+        Serial.println(STRUCTA_TEXT("4. Field names become JSON keys automatically"));
+        Serial.println(STRUCTA_TEXT("5. Validation is optional - use DEFINE_STRUCTA or DEFINE_STRUCTA_WITH_VALIDATION"));
+        Serial.println(STRUCTA_TEXT("6. Validation occurs automatically during deserializeWithResult()"));
+        Serial.println(STRUCTA_TEXT("====================================="));
     }
+#else
+    static void printExistingStructDefinition(const String&, const String&) {}
+    static void showMacroWritingGuide() {}
+#endif
 };
 
+#if STRUCTA_MEMORY_TRACKER
 size_t MemoryTracker::totalAllocated = 0;
 size_t MemoryTracker::peakUsage = 0;
+size_t MemoryTracker::peakDocumentUsage = 0;
+size_t MemoryTracker::totalOutput = 0;
+size_t MemoryTracker::operationCounts[MemoryTracker::OPERATION_COUNT] = {};
+size_t MemoryTracker::minFreeHeap = 0;
+size_t MemoryTracker::minLargestBlock = 0;
+MemoryTracker::TypeStats* MemoryTracker::typeList = nullptr;
+MemoryTracker::QueueStats* MemoryTracker::queueList = nullptr;
+#if STRUCTA_TRACK_TASKS
+MemoryTracker::TaskStats MemoryTracker::taskStats[STRUCTA_MAX_TRACKED_TASKS] = {};
+#endif
+#endif
+#if STRUCTA_THREAD_SAFE && defined(ESP32) && !defined(STRUCTA_LOCK)
+portMUX_TYPE StructaLock::mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
 
 // ======================================================
 // Type Detection (renamed to avoid conflicts)
@@ -358,384 +785,4836 @@ public:
 };
 
 // ======================================================
-// Base Class
+// Key Lookup
 // ======================================================
-class JsonStruct {
-protected:
-    // Serialize primitives
-    template<typename T>
-    static typename std::enable_if<!HasSerialize<T>::value, void>::type
-    serializeField(JsonObject& obj, const char* key, const T& value) {
-        obj[key] = value;
+// Generated deserializeFields() walks the parsed object once and switches on
+// a 32-bit FNV-1a hash of each key, with the case labels computed at compile
+// time from FIELD_LIST, then confirms the match with a single strcmp. Two
+// field names with the same hash would give duplicate case labels, so a
+// collision fails to compile rather than misrouting a value.
+struct StructaKey {
+    static constexpr uint32_t hash(const char* s, uint32_t h = 2166136261u) {
+        return *s ? hash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
     }
-    
-    // Serialize nested structs
-    template<typename T>
-    static typename std::enable_if<HasSerialize<T>::value, void>::type
-    serializeField(JsonObject& obj, const char* key, const T& value) {
-        DynamicJsonDocument sub(256);
-        deserializeJson(sub, value.serialize());
-        obj[key] = sub.as<JsonObject>();
+
+    static uint32_t hashRuntime(const char* s) {
+        uint32_t h = 2166136261u;
+        while (*s) h = (h ^ (uint8_t)*s++) * 16777619u;
+        return h;
     }
-    
-    // Deserialize primitives
-    template<typename T>
-    static typename std::enable_if<!HasSerialize<T>::value, void>::type
-    deserializeField(const JsonObject& obj, const char* key, T& value) {
-        if (obj.containsKey(key)) {
-            value = obj[key].as<T>();
-        }
+};
+
+// Order-dependent combination of 32-bit words, for fingerprints built from
+// key hashes: structaFold(seed, a, b, ...)
+constexpr uint32_t structaMix(uint32_t h, uint32_t word) {
+    return ((h ^ word) * 16777619u) ^ (((h ^ word) * 16777619u) >> 15);
+}
+
+constexpr uint32_t structaFold(uint32_t h) { return h; }
+template<typename... Rest>
+constexpr uint32_t structaFold(uint32_t h, uint32_t word, Rest... rest) {
+    return structaFold(structaMix(h, word), rest...);
+}
+
+// ======================================================
+// Array Fields
+// ======================================================
+// Fixed-size arrays can be declared directly: field(float[16], samples).
+// StructaArray<T, N> is a bounded list holding up to N items, of which only
+// the first count() are serialized. Give it a typedef first, since the comma
+// in the template arguments would split the field(...) macro arguments:
+//   typedef StructaArray<Reading, 8> ReadingList;
+//   field(ReadingList, readings)
+template<typename T, size_t N>
+struct StructaArray {
+    T items[N];
+    size_t count;
+
+    StructaArray() : count(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= N; }
+    void clear() { count = 0; }
+
+    bool push_back(const T& value) {
+        if (count >= N) return false;
+        items[count++] = value;
+        return true;
     }
-    
-    // Deserialize nested structs
-    template<typename T>
-    static typename std::enable_if<HasSerialize<T>::value, void>::type
-    deserializeField(const JsonObject& obj, const char* key, T& value) {
-        if (obj.containsKey(key) && obj[key].is<JsonObject>()) {
-            JsonObject sub = obj[key].as<JsonObject>();
-            value = T::deserialize(sub);
-        }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+};
+
+// ======================================================
+// Fixed Strings
+// ======================================================
+// StructaFixedString<N> keeps up to N characters inside the struct, so a
+// name or id that would be a String costs no heap allocation per instance:
+//   typedef StructaFixedString<16> DeviceName;
+//   field(DeviceName, deviceName, META_STRLEN(1, 16))
+// Longer text is cut to N characters when assigned or parsed; documents
+// checked against a rule reject it as "String too long". Like const char*
+// members, the text is linked into an outgoing document, not copied.
+template<size_t N>
+struct StructaFixedString {
+    char text[N + 1];
+
+    StructaFixedString() { text[0] = '\0'; }
+    StructaFixedString(const char* s) { assign(s); }
+    StructaFixedString(const String& s) { assign(s.c_str(), s.length()); }
+
+    static constexpr size_t capacity() { return N; }
+    const char* c_str() const { return text; }
+    size_t length() const { return strlen(text); }
+    bool empty() const { return text[0] == '\0'; }
+    void clear() { text[0] = '\0'; }
+
+    // False when s was cut to fit
+    bool assign(const char* s) {
+        if (!s) { clear(); return true; }
+        return assign(s, strlen(s));
+    }
+    bool assign(const char* s, size_t length) {
+        size_t n = length < N ? length : N;
+        memcpy(text, s, n);
+        text[n] = '\0';
+        return n == length;
+    }
+
+    friend bool operator==(const StructaFixedString& a, const StructaFixedString& b) {
+        return strcmp(a.text, b.text) == 0;
     }
+    friend bool operator==(const StructaFixedString& a, const char* b) { return b && strcmp(a.text, b) == 0; }
+    friend bool operator!=(const StructaFixedString& a, const StructaFixedString& b) { return !(a == b); }
+    friend bool operator!=(const StructaFixedString& a, const char* b) { return !(a == b); }
 };
 
+// Lets DECLARE accept array types such as float[16]
+template<typename T>
+struct StructaFieldType { typedef T declared; };
+
+// What a View getter returns for a member; arrays, which cannot be returned,
+// come back as a StructaArray of the same capacity
+template<typename T>
+struct StructaViewValue { typedef T Value; };
+template<typename T, size_t N>
+struct StructaViewValue<T[N]> { typedef StructaArray<T, N> Value; };
+
 // ======================================================
-// Macros
+// Enumerations
 // ======================================================
-#define DECLARE(type, name) type name;
-#define SERIALIZE_FIELD(type, name) serializeField(obj, #name, name);
-#define DESERIALIZE_FIELD(type, name) deserializeField(o, #name, data.name);
+// A closed set of names, listed like a FIELD_LIST:
+//   #define ROLE_VALUES(value) value(admin) value(user) value(guest)
+//   STRUCTA_ENUM(Role, ROLE_VALUES)
+// Role::admin, Role::user... are small integers, Role::name(i) is the name
+// of one and Role::parse(text) its index. parse() switches on the name's
+// hash, so the compiler builds the lookup; names that collide fail to
+// compile. META_ENUM(Role::parse) checks a String field against the set.
+//
+// StructaEnum<Role> is a field holding one of them as a uint8_t; documents
+// carry the name, compact frames the index:
+//   field(StructaEnum<Role>, role, META_OPTIONAL())
+// A name that is not in the set leaves the member as it was, or fails as
+// "Invalid enum value" when the field has a rule.
+#define ENUM_CONSTANT(value) value,
+#define ENUM_NAME_TEXT(value) #value "\0"
+#define ENUM_NAME_OFFSET(value) NAME_AT_##value, NAME_END_##value = NAME_AT_##value + sizeof(#value) - 1,
+#define ENUM_NAME_LENGTH(value) sizeof(#value) - 1,
+#define ENUM_NAME_HASH(value) , StructaKey::hash(#value)
+#define ENUM_NAME_CASE(value) case value: return names() + NAME_AT_##value;
+#define ENUM_PARSE_CASE(value) \
+    case StructaKey::hash(#value): return STRUCTA_KEY_EQUALS(text, #value) ? value : -1;
 
-// NEW: Simple validation macros that avoid comma issues
-#define DECLARE_VALIDATOR(fieldName, validatorInstance) auto validator_##fieldName = validatorInstance;
-#define VALIDATE_FIELD(fieldName, validatorInstance) \
-    { \
-        String errMsg; \
-        if (!validator_##fieldName.validate(#fieldName, fieldName, errMsg)) { \
-            return SerializationResult<bool>::Failure( \
-                SerializationError::VALIDATION_FAILED, errMsg, #fieldName); \
-        } \
+constexpr size_t structaLongest(size_t length) { return length; }
+template<typename... Rest>
+constexpr size_t structaLongest(size_t a, size_t b, Rest... rest) {
+    return structaLongest(a > b ? a : b, rest...);
+}
+
+#define STRUCTA_ENUM(enumName, VALUE_LIST)                                   \
+struct enumName {                                                            \
+    enum Value : uint8_t { VALUE_LIST(ENUM_CONSTANT) COUNT };                \
+    enum NameOffset { VALUE_LIST(ENUM_NAME_OFFSET) NAME_BLOCK_SIZE };        \
+    enum { LONGEST_NAME = structaLongest(VALUE_LIST(ENUM_NAME_LENGTH) 0) };  \
+    enum : uint32_t { NAMES_HASH = structaFold(2166136261u VALUE_LIST(ENUM_NAME_HASH)) }; \
+                                                                             \
+    /* Every name, NUL-terminated; in flash with STRUCTA_USE_PROGMEM */      \
+    static const char* names() {                                             \
+        static const char text[] STRUCTA_PROGMEM = VALUE_LIST(ENUM_NAME_TEXT); \
+        return text;                                                         \
+    }                                                                        \
+                                                                             \
+    /* nullptr for an index out of range; see STRUCTA_FLASH */               \
+    static const char* name(uint8_t value) {                                 \
+        switch (value) {                                                     \
+            VALUE_LIST(ENUM_NAME_CASE)                                       \
+            default: return nullptr;                                         \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    /* Index of text, -1 when it is not one of the names */                  \
+    static int parse(const char* text) {                                     \
+        if (!text) return -1;                                                \
+        switch (StructaKey::hashRuntime(text)) {                             \
+            VALUE_LIST(ENUM_PARSE_CASE)                                      \
+            default: return -1;                                              \
+        }                                                                    \
+    }                                                                        \
+};
+
+template<typename E>
+struct StructaEnum {
+    typedef typename E::Value Value;
+    uint8_t value;
+
+    StructaEnum() : value(0) {}
+    StructaEnum(Value v) : value(v) {}
+
+    Value get() const { return (Value)value; }
+    bool valid() const { return value < E::COUNT; }
+    const char* name() const { return E::name(value); }   // see STRUCTA_FLASH
+
+    // False, leaving the value as it was, when text is not one of the names
+    bool parse(const char* text) {
+        int index = E::parse(text);
+        if (index < 0) return false;
+        value = (uint8_t)index;
+        return true;
     }
 
-// Helper functions to create validators without comma issues
-inline RangeValidator<int> makeRangeValidatorInt(int min, int max) {
-    return RangeValidator<int>(min, max);
+    friend bool operator==(StructaEnum a, StructaEnum b) { return a.value == b.value; }
+    friend bool operator!=(StructaEnum a, StructaEnum b) { return a.value != b.value; }
+};
+
+// ======================================================
+// Field Rules
+// ======================================================
+// A field may carry a rule as its third argument, e.g.
+// field(int, age, META_RANGE(18, 100)). The rules of a struct form a constant
+// schema table (in flash with STRUCTA_USE_PROGMEM) that is checked when a
+// value is written and when a document is read; fields without one, and
+// structs without any, cost nothing. With STRUCTA_USE_PROGMEM, META_ENUM
+// tables must be flash tables of flash strings:
+//   const char roleAdmin[] PROGMEM = "admin";
+//   const char roleUser[] PROGMEM = "user";
+//   const char* const roles[] PROGMEM = {roleAdmin, roleUser};
+// A STRUCTA_ENUM needs neither: META_ENUM(Role::parse) looks names up in its
+// switch. Each field's rule is a type of its own, so the checks and limits
+// are compiled into the field's case and unused checks generate no code.
+//
+// The same argument selects a numeric encoding for float and double fields,
+// on its own or chained onto a rule:
+//   field(float, humidity, META_SCALED(100))           // 41.27 -> 4127
+//   field(float, temperature, META_RANGE(-40, 85).fixed(1))  // 21.53 -> 21.5
+// Encoded values are formatted and parsed with integer arithmetic, and their
+// range checks compare scaled integers. META_FIXED writes its decimal text
+// into the document as raw JSON, so it is for JSON output only; links that
+// use MessagePack should use META_SCALED. Compact frames carry both as the
+// scaled integer.
+constexpr int32_t structaPow10(uint8_t exponent) {
+    return exponent == 0 ? 1 : 10 * structaPow10(exponent - 1);
 }
 
-inline RangeValidator<float> makeRangeValidatorFloat(float min, float max) {
-    return RangeValidator<float>(min, max);
+// Literal type, so the schema table built from it is constant-initialized
+// and can be placed in flash
+struct FieldMeta {
+    float minValue;
+    float maxValue;
+    int minLength;
+    int maxLength;
+    const char* const* allowedValues;
+    size_t allowedCount;
+    bool required;
+    bool validate;
+    int32_t scale;      // 0, or the factor a float travels as an integer by
+    uint8_t decimals;   // > 0 writes that many fraction digits as text
+    int (*lookup)(const char*);   // STRUCTA_ENUM parse() in place of allowedValues
+
+    constexpr FieldMeta(float minV = NAN, float maxV = NAN, int minL = -1, int maxL = -1,
+                        const char* const* values = nullptr, size_t count = 0,
+                        bool req = true, bool val = true, int32_t s = 0, uint8_t d = 0,
+                        int (*find)(const char*) = nullptr)
+        : minValue(minV), maxValue(maxV), minLength(minL), maxLength(maxL),
+          allowedValues(values), allowedCount(count), required(req), validate(val),
+          scale(s), decimals(d), lookup(find) {}
+
+    // The same rule with the value sent as round(value * s)
+    constexpr FieldMeta scaled(int32_t s) const {
+        return FieldMeta(minValue, maxValue, minLength, maxLength, allowedValues, allowedCount,
+                         required, validate, s, 0, lookup);
+    }
+
+    // The same rule with the value sent as text with d fraction digits
+    constexpr FieldMeta fixed(uint8_t d) const {
+        return FieldMeta(minValue, maxValue, minLength, maxLength, allowedValues, allowedCount,
+                         required, validate, structaPow10(d), d, lookup);
+    }
+};
+
+constexpr FieldMeta makeMetaNone() {
+    return FieldMeta(NAN, NAN, -1, -1, nullptr, 0, true, false);
 }
 
-inline StringLengthValidator makeStringLengthValidator(size_t min, size_t max) {
-    return StringLengthValidator(min, max);
+constexpr FieldMeta makeMetaOptional() {
+    return FieldMeta(NAN, NAN, -1, -1, nullptr, 0, false, true);
 }
 
-inline StringLengthValidator makeStringMinLengthValidator(size_t min) {
-    return StringLengthValidator::minLength(min);
+constexpr FieldMeta makeMetaOptionalUnvalidated() {
+    return FieldMeta(NAN, NAN, -1, -1, nullptr, 0, false, false);
 }
 
-inline StringLengthValidator makeStringMaxLengthValidator(size_t max) {
-    return StringLengthValidator::maxLength(max);
+constexpr FieldMeta makeMetaRange(float minV, float maxV) {
+    return FieldMeta(minV, maxV);
 }
 
-inline RequiredValidator makeRequiredValidator() {
-    return RequiredValidator();
+constexpr FieldMeta makeMetaStrlen(int minL, int maxL) {
+    return FieldMeta(NAN, NAN, minL, maxL);
 }
 
-template<typename T>
-inline CustomValidator<T> makeCustomValidator(bool (*func)(T), const String& errorMsg = "Custom validation failed") {
-    return CustomValidator<T>(func, errorMsg);
+constexpr FieldMeta makeMetaEnum(const char* const* values, size_t count) {
+    return FieldMeta(NAN, NAN, -1, -1, values, count);
 }
 
-// ======================================================
-// Main Struct Definition Macro
-// ======================================================
-#define DEFINE_STRUCTA(structName, FIELD_LIST)                             \
-struct structName : public JsonStruct {                                   \
-    FIELD_LIST(DECLARE)                                                   \
-                                                                              \
-    SerializationResult<String> serializeWithResult() const {                \
-        DynamicJsonDocument doc(512);                                        \
-        MemoryTracker::recordAllocation(512);                                \
-        JsonObject obj = doc.to<JsonObject>();                               \
-        FIELD_LIST(SERIALIZE_FIELD)                                       \
-        String result;                                                        \
-        if(serializeJson(doc, result) == 0) {                                \
-            MemoryTracker::recordDeallocation(512);                          \
-            return SerializationResult<String>::Failure(                     \
-                SerializationError::INVALID_JSON, "Failed to serialize");    \
-        }                                                                     \
-        MemoryTracker::recordDeallocation(512);                              \
-        return SerializationResult<String>::Success(result);                 \
-    }                                                                         \
-                                                                              \
-    String serialize() const {                                                \
-        auto result = serializeWithResult();                                 \
-        return result.success ? result.data : "{}";                          \
-    }                                                                         \
-                                                                              \
-    static SerializationResult<structName> deserializeWithResult(const String& jsonStr) { \
-        DynamicJsonDocument doc(512);                                        \
-        MemoryTracker::recordAllocation(512);                                \
-        DeserializationError err = deserializeJson(doc, jsonStr);            \
-        if(err) {                                                             \
-            MemoryTracker::recordDeallocation(512);                          \
-            return SerializationResult<structName>::Failure(                 \
-                SerializationError::INVALID_JSON, String("Parse error: ") + err.c_str()); \
-        }                                                                     \
-        JsonObject o = doc.as<JsonObject>();                                 \
-        structName data;                                                      \
-        FIELD_LIST(DESERIALIZE_FIELD)                                     \
-        MemoryTracker::recordDeallocation(512);                              \
-        return SerializationResult<structName>::Success(data);               \
-    }                                                                         \
-                                                                              \
-    static SerializationResult<structName> deserializeWithResult(const JsonObject& o) { \
-        structName data;                                                      \
-        FIELD_LIST(DESERIALIZE_FIELD)                                     \
-        return SerializationResult<structName>::Success(data);               \
-    }                                                                         \
-                                                                              \
-    static structName deserialize(const String& jsonStr) {                   \
-        auto result = deserializeWithResult(jsonStr);                        \
-        return result.success ? result.data : structName();                  \
-    }                                                                         \
-                                                                              \
-    static structName deserialize(const JsonObject& o) {                     \
-        auto result = deserializeWithResult(o);                              \
-        return result.success ? result.data : structName();                  \
-    }                                                                         \
-                                                                              \
-    static void printStructDefinition() {                                    \
-        Serial.println("=== " #structName " Struct Definition ===");        \
-        Serial.println("Struct Name: " #structName);                         \
-        Serial.println("Generated Methods:");                                 \
-        Serial.println("  - serialize() -> String");                         \
-        Serial.println("  - serializeWithResult() -> SerializationResult<String>"); \
-        Serial.println("  - deserialize(String) -> " #structName);           \
-        Serial.println("  - deserialize(JsonObject) -> " #structName);       \
-        Serial.println("  - deserializeWithResult(String) -> SerializationResult<" #structName ">"); \
-        Serial.println("  - deserializeWithResult(JsonObject) -> SerializationResult<" #structName ">"); \
-        Serial.println("  - printStructDefinition() -> void");               \
-        Serial.println("  - printFieldInfo() -> void");                      \
-        Serial.println("  - printCurrentValues() -> void");                  \
-        Serial.println();                                                     \
-        Serial.println("Usage Example:");                                     \
-        Serial.println("  " #structName " obj;");                            \
-        Serial.println("  String json = obj.serialize();");                  \
-        Serial.println("  " #structName " copy = " #structName "::deserialize(json);"); \
-        Serial.println("=======================================");             \
-    }                                                                         \
-                                                                              \
-    static void printFieldInfo() {                                           \
-        Serial.println("=== " #structName " Field Information ===");        \
-        Serial.println("To see actual field values, create an instance and call printCurrentValues()"); \
-        Serial.println();                                                     \
-        Serial.println("Macro Definition Pattern:");                         \
-        Serial.println("#define " #structName "_FIELDS(field) \\");          \
-        Serial.println("    field(Type, fieldName) \\");                     \
-        Serial.println("    // ... more fields");                            \
-        Serial.println();                                                     \
-        Serial.println("Then use: DEFINE_STRUCTA(" #structName ", " #structName "_FIELDS)"); \
-        Serial.println();                                                     \
-        Serial.println("For detailed macro writing guide, call:");           \
-        Serial.println("MemoryTracker::showMacroWritingGuide();");           \
-        Serial.println("=========================================");          \
-    }                                                                         \
-                                                                              \
-    void printCurrentValues() const {                                        \
-        Serial.println("=== " #structName " Current Values ===");           \
-        String json = serialize();                                            \
-        Serial.println("JSON Representation:");                              \
-        Serial.println(json);                                                 \
-        Serial.println();                                                     \
-        Serial.println("Formatted Output:");                                 \
-        DynamicJsonDocument doc(512);                                        \
-        deserializeJson(doc, json);                                          \
-        JsonObject obj = doc.as<JsonObject>();                               \
-        for (JsonPair kv : obj) {                                            \
-            String fieldName = kv.key().c_str();                             \
-            String fieldValue;                                                \
-            if (kv.value().is<int>()) {                                      \
-                fieldValue = String(kv.value().as<int>());                   \
-            } else if (kv.value().is<float>()) {                             \
-                fieldValue = String(kv.value().as<float>(), 2);              \
-            } else if (kv.value().is<bool>()) {                              \
-                fieldValue = kv.value().as<bool>() ? "true" : "false";      \
-            } else if (kv.value().is<const char*>()) {                       \
-                fieldValue = "\"" + String(kv.value().as<const char*>()) + "\""; \
-            } else if (kv.value().is<JsonObject>()) {                        \
-                fieldValue = "[Nested Object]";                              \
-            } else {                                                          \
-                fieldValue = "[Unknown Type]";                               \
-            }                                                                 \
-            Serial.println("  " + fieldName + ": " + fieldValue);           \
-        }                                                                     \
-        Serial.println("=====================================");             \
-    }                                                                         \
+template<size_t N>
+constexpr FieldMeta makeMetaEnum(const char* const (&values)[N]) {
+    return makeMetaEnum(values, N);
+}
+
+// Names of a STRUCTA_ENUM, found through its hash switch
+constexpr FieldMeta makeMetaEnum(int (*lookup)(const char*)) {
+    return FieldMeta(NAN, NAN, -1, -1, nullptr, 0, true, true, 0, 0, lookup);
+}
+
+constexpr FieldMeta makeMetaScaled(int32_t scale) {
+    return makeMetaNone().scaled(scale);
+}
+
+constexpr FieldMeta makeMetaFixed(uint8_t decimals) {
+    return makeMetaNone().fixed(decimals);
+}
+
+// Rule of a field from its optional third argument; none means META_NONE()
+constexpr FieldMeta structaMeta() { return makeMetaNone(); }
+constexpr FieldMeta structaMeta(FieldMeta meta) { return meta; }
+
+#define META_NONE() makeMetaNone()
+#define META_OPTIONAL() makeMetaOptional()
+#define META_OPTIONAL_UNVALIDATED() makeMetaOptionalUnvalidated()
+#define META_RANGE(minV, maxV) makeMetaRange((minV), (maxV))
+#define META_STRLEN(minL, maxL) makeMetaStrlen((minL), (maxL))
+#define META_ENUM(values) makeMetaEnum((values))   // an array of names or a STRUCTA_ENUM's parse
+#define META_SCALED(scale) makeMetaScaled((scale))
+#define META_FIXED(decimals) makeMetaFixed((decimals))
+
+// Rounded half away from zero, saturated to the int32_t range the encoded
+// integer travels in; NaN becomes 0
+template<typename V>
+inline int32_t structaRoundScaled(V scaled) {
+    if (!(scaled == scaled)) return 0;
+    if (scaled >= (V)INT32_MAX) return INT32_MAX;
+    if (scaled <= (V)INT32_MIN) return INT32_MIN;
+    return (int32_t)(scaled < 0 ? scaled - (V)0.5 : scaled + (V)0.5);
+}
+
+// View of an encoded member; raw() is the scaled integer it travels as
+template<typename T, int32_t Scale, uint8_t Decimals>
+struct StructaScaled {
+    typedef typename std::remove_const<T>::type Value;
+    static_assert(std::is_floating_point<Value>::value, "META_SCALED and META_FIXED apply to float and double fields");
+    static_assert(Scale > 0, "META_SCALED needs a positive scale");
+    static_assert(Decimals <= 9, "META_FIXED allows at most 9 decimals");
+    static const size_t TEXT_SIZE = 16;   // sign, ten digits, point and NUL
+
+    T& value;
+
+    explicit StructaScaled(T& member) : value(member) {}
+
+    // Values beyond the int32_t range are written as its nearest limit
+    int32_t raw() const { return structaRoundScaled(value * (Value)Scale); }
+
+    void setRaw(long raw) const { value = (Value)raw / (Value)Scale; }
+
+    // raw() as decimal text with exactly Decimals fraction digits; returns
+    // its length
+    size_t format(char* out) const {
+        int32_t scaled = raw();
+        uint32_t magnitude = scaled < 0 ? 0U - (uint32_t)scaled : (uint32_t)scaled;
+        char digits[10];   // INT32_MIN has ten digits
+        size_t count = 0;
+        do {
+            digits[count++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0 || count <= Decimals);
+        size_t length = 0;
+        if (scaled < 0) out[length++] = '-';
+        while (count > 0) {
+            if (count == Decimals) out[length++] = '.';
+            out[length++] = digits[--count];
+        }
+        out[length] = '\0';
+        return length;
+    }
 };
 
-// ======================================================
-// NEW: Struct Definition WITH Validation Support
-// ======================================================
-#define DEFINE_STRUCTA_WITH_VALIDATION(structName, FIELD_LIST, VALIDATOR_LIST) \
-struct structName : public JsonStruct {                                   \
-    FIELD_LIST(DECLARE)                                                   \
-    VALIDATOR_LIST(DECLARE_VALIDATOR)                                     \
-                                                                              \
-    structName() {}                                                       \
-                                                                              \
-    SerializationResult<bool> validate() const {                            \
-        VALIDATOR_LIST(VALIDATE_FIELD)                                    \
-        return SerializationResult<bool>::Success(true);                    \
-    }                                                                         \
-                                                                              \
-    SerializationResult<String> serializeWithResult() const {                \
-        DynamicJsonDocument doc(512);                                        \
-        MemoryTracker::recordAllocation(512);                                \
-        JsonObject obj = doc.to<JsonObject>();                               \
-        FIELD_LIST(SERIALIZE_FIELD)                                       \
-        String result;                                                        \
-        if(serializeJson(doc, result) == 0) {                                \
-            MemoryTracker::recordDeallocation(512);                          \
-            return SerializationResult<String>::Failure(                     \
-                SerializationError::INVALID_JSON, "Failed to serialize");    \
-        }                                                                     \
-        MemoryTracker::recordDeallocation(512);                              \
-        return SerializationResult<String>::Success(result);                 \
-    }                                                                         \
-                                                                              \
-    String serialize() const {                                                \
-        auto result = serializeWithResult();                                 \
-        return result.success ? result.data : "{}";                          \
-    }                                                                         \
-                                                                              \
-    static SerializationResult<structName> deserializeWithResult(const String& jsonStr, bool validateData = true) { \
-        DynamicJsonDocument doc(512);                                        \
-        MemoryTracker::recordAllocation(512);                                \
-        DeserializationError err = deserializeJson(doc, jsonStr);            \
-        if(err) {                                                             \
-            MemoryTracker::recordDeallocation(512);                          \
-            return SerializationResult<structName>::Failure(                 \
-                SerializationError::INVALID_JSON, String("Parse error: ") + err.c_str()); \
-        }                                                                     \
-        JsonObject o = doc.as<JsonObject>();                                 \
-        structName data;                                                      \
-        FIELD_LIST(DESERIALIZE_FIELD)                                     \
-        MemoryTracker::recordDeallocation(512);                              \
-        if (validateData) {                                                   \
-            auto validationResult = data.validate();                         \
-            if (!validationResult.success) {                                 \
-                return SerializationResult<structName>::Failure(             \
-                    validationResult.error.code,                             \
-                    validationResult.error.message,                          \
-                    validationResult.error.fieldPath);                       \
-            }                                                                 \
-        }                                                                     \
-        return SerializationResult<structName>::Success(data);               \
-    }                                                                         \
-                                                                              \
-    static SerializationResult<structName> deserializeWithResult(const JsonObject& o, bool validateData = true) { \
-        structName data;                                                      \
-        FIELD_LIST(DESERIALIZE_FIELD)                                     \
-        if (validateData) {                                                   \
-            auto validationResult = data.validate();                         \
-            if (!validationResult.success) {                                 \
-                return SerializationResult<structName>::Failure(             \
-                    validationResult.error.code,                             \
-                    validationResult.error.message,                          \
-                    validationResult.error.fieldPath);                       \
-            }                                                                 \
-        }                                                                     \
-        return SerializationResult<structName>::Success(data);               \
-    }                                                                         \
-                                                                              \
-    static structName deserialize(const String& jsonStr, bool validateData = false) { \
-        auto result = deserializeWithResult(jsonStr, validateData);          \
-        return result.success ? result.data : structName();                  \
-    }                                                                         \
-                                                                              \
-    static structName deserialize(const JsonObject& o, bool validateData = false) { \
-        auto result = deserializeWithResult(o, validateData);                \
-        return result.success ? result.data : structName();                  \
-    }                                                                         \
-                                                                              \
-    static void printStructDefinition() {                                    \
-        Serial.println("=== " #structName " Struct Definition (WITH VALIDATION) ==="); \
-        Serial.println("Struct Name: " #structName);                         \
-        Serial.println("Generated Methods:");                                 \
-        Serial.println("  - serialize() -> String");                         \
-        Serial.println("  - serializeWithResult() -> SerializationResult<String>"); \
-        Serial.println("  - deserialize(String, validate=false) -> " #structName); \
-        Serial.println("  - deserialize(JsonObject, validate=false) -> " #structName); \
-        Serial.println("  - deserializeWithResult(String, validate=true) -> SerializationResult<" #structName ">"); \
-        Serial.println("  - deserializeWithResult(JsonObject, validate=true) -> SerializationResult<" #structName ">"); \
-        Serial.println("  - validate() -> SerializationResult<bool>");      \
-        Serial.println("  - printStructDefinition() -> void");               \
-        Serial.println("  - printFieldInfo() -> void");                      \
-        Serial.println("  - printCurrentValues() -> void");                  \
-        Serial.println();                                                     \
-        Serial.println("Usage Example:");                                     \
-        Serial.println("  " #structName " obj;");                            \
-        Serial.println("  String json = obj.serialize();");                  \
-        Serial.println("  auto result = " #structName "::deserializeWithResult(json);"); \
-        Serial.println("  if (!result.success) {");                          \
-        Serial.println("    Serial.println(result.error.toString());");      \
-        Serial.println("  }");                                                \
-        Serial.println("=======================================");             \
-    }                                                                         \
-                                                                              \
-    static void printFieldInfo() {                                           \
-        Serial.println("=== " #structName " Field Information (WITH VALIDATION) ==="); \
-        Serial.println("This struct includes automatic validation on deserialization."); \
-        Serial.println("To see actual field values, create an instance and call printCurrentValues()"); \
-        Serial.println();                                                     \
-        Serial.println("Validation is performed automatically in deserializeWithResult()"); \
-        Serial.println("You can also manually validate with: obj.validate()"); \
-        Serial.println();                                                     \
-        Serial.println("For detailed macro writing guide with validation, call:"); \
-        Serial.println("MemoryTracker::showMacroWritingGuide();");           \
-        Serial.println("=========================================");          \
-    }                                                                         \
-                                                                              \
-    void printCurrentValues() const {                                        \
-        Serial.println("=== " #structName " Current Values ===");           \
-        String json = serialize();                                            \
-        Serial.println("JSON Representation:");                              \
-        Serial.println(json);                                                 \
-        Serial.println();                                                     \
-        Serial.println("Formatted Output:");                                 \
-        DynamicJsonDocument doc(512);                                        \
-        deserializeJson(doc, json);                                          \
-        JsonObject obj = doc.as<JsonObject>();                               \
-        for (JsonPair kv : obj) {                                            \
-            String fieldName = kv.key().c_str();                             \
-            String fieldValue;                                                \
-            if (kv.value().is<int>()) {                                      \
-                fieldValue = String(kv.value().as<int>());                   \
-            } else if (kv.value().is<float>()) {                             \
-                fieldValue = String(kv.value().as<float>(), 2);              \
-            } else if (kv.value().is<bool>()) {                              \
-                fieldValue = kv.value().as<bool>() ? "true" : "false";      \
-            } else if (kv.value().is<const char*>()) {                       \
-                fieldValue = "\"" + String(kv.value().as<const char*>()) + "\""; \
-            } else if (kv.value().is<JsonObject>()) {                        \
-                fieldValue = "[Nested Object]";                              \
-            } else {                                                          \
-                fieldValue = "[Unknown Type]";                               \
-            }                                                                 \
-            Serial.println("  " + fieldName + ": " + fieldValue);           \
-        }                                                                     \
-        Serial.println();                                                     \
-        Serial.println("Validation Status:");                                \
-        auto validationResult = validate();                                  \
-        if (validationResult.success) {                                      \
-            Serial.println("  ✓ All validations passed");                   \
-        } else {                                                              \
-            Serial.println("  ✗ Validation failed:");                       \
-            Serial.println("    " + validationResult.error.toString());     \
-        }                                                                     \
-        Serial.println("=====================================");             \
-    }                                                                         \
+// Picks what the field helpers see for a member: encoded floats get a
+// StructaScaled view, every other member is passed through as it is
+template<int32_t Scale, uint8_t Decimals>
+struct StructaCoding {
+    template<typename T>
+    static StructaScaled<T, Scale, Decimals> wrap(T& member) { return StructaScaled<T, Scale, Decimals>(member); }
+    template<typename T>
+    struct Field { typedef StructaScaled<T, Scale, Decimals> type; };
+};
+
+template<uint8_t Decimals>
+struct StructaCoding<0, Decimals> {
+    template<typename T>
+    static T& wrap(T& member) { return member; }
+    template<typename T>
+    struct Field { typedef T type; };
+};
+
+#define STRUCTA_CODING(...) StructaCoding<structaMeta(__VA_ARGS__).scale, structaMeta(__VA_ARGS__).decimals>
+#define STRUCTA_CODED(member, ...) STRUCTA_CODING(__VA_ARGS__)::wrap(member)
+#define STRUCTA_CODED_TYPE(memberType, ...) \
+    STRUCTA_CODING(__VA_ARGS__)::Field<StructaFieldType<memberType>::declared>::type
+
+#if STRUCTA_VALIDATION
+enum class FieldType { INT, FLOAT, BOOL, STRING, OBJECT, UNKNOWN };
+
+struct FieldSchema {
+    const char* name;
+    FieldType type;
+    bool required;
+    bool validate;
+    float minValue;
+    float maxValue;
+    int minLength;
+    int maxLength;
+    const char* const* allowedValues;
+    size_t allowedCount;
+    int32_t scale;
+    uint8_t decimals;
+};
+
+// Entries may live in flash (STRUCTA_USE_PROGMEM); always read them through this
+inline FieldSchema structaLoadSchema(const FieldSchema* entry) {
+#if STRUCTA_USE_PROGMEM
+    FieldSchema f;
+    memcpy_P(&f, entry, sizeof(f));
+    return f;
+#else
+    return *entry;
+#endif
+}
+
+template<typename T, bool hasSerialize = HasSerialize<T>::value>
+struct StructaTypeResolver {
+    static constexpr FieldType value =
+        std::is_same<T, bool>::value ? FieldType::BOOL :
+        std::is_integral<T>::value ? FieldType::INT :
+        std::is_floating_point<T>::value ? FieldType::FLOAT : FieldType::UNKNOWN;
+};
+template<typename T> struct StructaTypeResolver<T, true> { static constexpr FieldType value = FieldType::OBJECT; };
+template<> struct StructaTypeResolver<String, false> { static constexpr FieldType value = FieldType::STRING; };
+template<size_t N> struct StructaTypeResolver<StructaFixedString<N>, false> { static constexpr FieldType value = FieldType::STRING; };
+template<typename E> struct StructaTypeResolver<StructaEnum<E>, false> { static constexpr FieldType value = FieldType::STRING; };
+template<> struct StructaTypeResolver<const char*, false> { static constexpr FieldType value = FieldType::STRING; };
+
+// A limit in scaled units; an unset (NaN) limit becomes the widest value
+constexpr long structaScaleLimit(float limit, int32_t scale, long unset) {
+    return (limit != limit || scale == 0) ? unset
+         : (long)(limit * scale + (limit < 0 ? -0.5f : 0.5f));
+}
+
+constexpr FieldSchema makeFieldSchema(const char* name, FieldType type, FieldMeta meta) {
+    return FieldSchema{ name, type, meta.required, meta.validate, meta.minValue, meta.maxValue,
+                        meta.minLength, meta.maxLength, meta.allowedValues, meta.allowedCount,
+                        meta.scale, meta.decimals };
+}
+
+// One field's rule, resolved at compile time from Rule::meta(): a check the
+// rule does not ask for is a constant false and drops out, and the limits
+// are constants. Rule is the type STRUCTA_FIELD_RULES declares per field.
+// Each check returns nullptr when the value is valid, otherwise a static
+// message.
+template<typename Rule>
+struct StructaRule {
+    enum {
+        CHECKED = Rule::meta().validate,
+        REQUIRED = CHECKED && Rule::meta().required,
+        HAS_MIN = CHECKED && Rule::meta().minValue == Rule::meta().minValue,   // not NaN
+        HAS_MAX = CHECKED && Rule::meta().maxValue == Rule::meta().maxValue,
+        HAS_MIN_LENGTH = CHECKED && Rule::meta().minLength >= 0,
+        HAS_MAX_LENGTH = CHECKED && Rule::meta().maxLength >= 0,
+        HAS_VALUES = CHECKED && (Rule::meta().allowedValues != nullptr || Rule::meta().lookup != nullptr),
+        HAS_RANGE = HAS_MIN || HAS_MAX,
+        HAS_LOOKUP = Rule::meta().lookup != nullptr
+    };
+    static constexpr float MIN = Rule::meta().minValue;
+    static constexpr float MAX = Rule::meta().maxValue;
+    static constexpr long MIN_LONG = HAS_MIN ? (long)Rule::meta().minValue : LONG_MIN;
+    static constexpr long MAX_LONG = HAS_MAX ? (long)Rule::meta().maxValue : LONG_MAX;
+    static constexpr long MIN_SCALED = structaScaleLimit(Rule::meta().minValue, Rule::meta().scale, LONG_MIN);
+    static constexpr long MAX_SCALED = structaScaleLimit(Rule::meta().maxValue, Rule::meta().scale, LONG_MAX);
+    static constexpr int MIN_LENGTH = Rule::meta().minLength;
+    static constexpr int MAX_LENGTH = Rule::meta().maxLength;
+    static constexpr int32_t SCALE = Rule::meta().scale;
+    static constexpr uint8_t DECIMALS = Rule::meta().decimals;
+    static constexpr const char* const* VALUES = Rule::meta().allowedValues;
+    static constexpr size_t VALUE_COUNT = Rule::meta().allowedCount;
+    static constexpr int (*LOOKUP)(const char*) = Rule::meta().lookup;
+
+    // ---- Members ----
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, const char*>::type
+    member(T value) {
+        if (HAS_MIN && (long)value < MIN_LONG) return "Value below min";
+        if (HAS_MAX && (long)value > MAX_LONG) return "Value above max";
+        return nullptr;
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, const char*>::type
+    member(T value) {
+        if (HAS_MIN && (float)value < MIN) return "Value below min";
+        if (HAS_MAX && (float)value > MAX) return "Value above max";
+        return nullptr;
+    }
+
+    // Encoded floats compare their scaled integer with the scaled limits
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static const char* member(const StructaScaled<T, Scale, Decimals>& value) {
+        return HAS_RANGE ? scaled(value.raw()) : nullptr;
+    }
+
+    static const char* member(bool) { return nullptr; }
+    static const char* member(const String& value) { return text(value.c_str()); }
+    static const char* member(const char* value) { return value ? text(value) : nullptr; }
+
+    template<size_t N>
+    static const char* member(const StructaFixedString<N>& value) { return text(value.c_str()); }
+
+    template<typename E>
+    static const char* member(const StructaEnum<E>& value) {
+        return CHECKED && !value.valid() ? "Invalid enum value" : nullptr;
+    }
+
+    // Nested structs and arrays: the member type already guarantees the shape
+    template<typename T>
+    static typename std::enable_if<!std::is_arithmetic<T>::value, const char*>::type
+    member(const T&) { return nullptr; }
+
+    // ---- Incoming values; T is the member's declared type ----
+    static const char* missing() { return REQUIRED ? "Required field missing" : nullptr; }
+
+    template<typename T>
+    static const char* value(JsonVariant v) {
+        return CHECKED ? valueOf(v, static_cast<const T*>(nullptr)) : nullptr;
+    }
+
+    static const char* scaled(long raw) {
+        if (HAS_MIN && raw < MIN_SCALED) return "Value below min";
+        if (HAS_MAX && raw > MAX_SCALED) return "Value above max";
+        return nullptr;
+    }
+
+    static const char* text(const char* s) {
+        if (HAS_MIN_LENGTH || HAS_MAX_LENGTH) {
+            int len = strlen(s);
+            if (HAS_MIN_LENGTH && len < MIN_LENGTH) return "String too short";
+            if (HAS_MAX_LENGTH && len > MAX_LENGTH) return "String too long";
+        }
+        if (HAS_VALUES && !allowed(s)) return "Invalid enum value";
+        return nullptr;
+    }
+
+private:
+    static const char* mismatch() { return "Expected different type"; }
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, const char*>::type
+    valueOf(JsonVariant v, const T*) {
+        if (!v.is<long>() && !v.is<int>()) return mismatch();
+        return HAS_RANGE ? member(v.as<long>()) : nullptr;
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, const char*>::type
+    valueOf(JsonVariant v, const T*) {
+        if (!v.is<float>() && !v.is<double>()) return mismatch();
+        if (!HAS_RANGE) return nullptr;
+        return SCALE ? scaled(scaledValue(v)) : member(v.as<float>());
+    }
+
+    static const char* valueOf(JsonVariant v, const bool*) { return v.is<bool>() ? nullptr : mismatch(); }
+    static const char* valueOf(JsonVariant v, const String*) { return textOf(v); }
+    static const char* valueOf(JsonVariant v, const char* const*) { return textOf(v); }
+
+    // Text is checked before it would be cut to the member's capacity
+    template<size_t N>
+    static const char* valueOf(JsonVariant v, const StructaFixedString<N>*) {
+        if (!v.is<const char*>()) return mismatch();
+        const char* s = v.as<const char*>();
+        return strlen(s) > N ? "String too long" : text(s);
+    }
+
+    template<typename E>
+    static const char* valueOf(JsonVariant v, const StructaEnum<E>*) {
+        if (!v.is<const char*>()) return mismatch();
+        const char* s = v.as<const char*>();
+        return E::parse(s) < 0 ? "Invalid enum value" : text(s);
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, const char*>::type
+    valueOf(JsonVariant v, const T*) { return v.is<JsonObject>() ? nullptr : mismatch(); }
+
+    // Arrays and other members are not type-checked
+    template<typename T>
+    static typename std::enable_if<!std::is_arithmetic<T>::value && !HasSerialize<T>::value, const char*>::type
+    valueOf(JsonVariant, const T*) { return nullptr; }
+
+    static const char* textOf(JsonVariant v) {
+        if (!v.is<const char*>()) return mismatch();
+        return text(v.as<const char*>());
+    }
+
+    // META_SCALED sends scaled units as is; META_FIXED decimal text that
+    // parsed as an integer needs no float work
+    static long scaledValue(JsonVariant v) {
+        bool integer = v.is<long>();
+        if (DECIMALS == 0) return integer ? v.as<long>() : (long)v.as<float>();
+        if (integer) return v.as<long>() * SCALE;
+        float scaled = v.as<float>() * SCALE;
+        return (long)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+    }
+
+    static bool allowed(const char* s) {
+        if (HAS_LOOKUP) return LOOKUP(s) >= 0;
+        for (size_t j = 0; j < VALUE_COUNT; ++j) {
+#if STRUCTA_USE_PROGMEM
+            if (strcmp_P(s, (const char*)pgm_read_ptr(&VALUES[j])) == 0) return true;
+#else
+            if (strcmp(s, VALUES[j]) == 0) return true;
+#endif
+        }
+        return false;
+    }
+};
+
+// Collects every failing field instead of stopping at the first one. Entries
+// hold only a schema index, a code and a static message; text is built on
+// demand by get()/toString(), so a clean validation does no heap work.
+#ifndef STRUCTA_MAX_ERRORS
+#define STRUCTA_MAX_ERRORS 8
+#endif
+
+struct StructaFieldError {
+    static const uint8_t NO_FIELD = 0xFF;   // error not tied to a field (e.g. parse failure)
+    uint8_t fieldIndex;
+    SerializationError code;
+    const char* message;
+};
+
+struct StructaErrorList {
+    StructaFieldError errors[STRUCTA_MAX_ERRORS];
+    size_t count;
+    bool truncated;                 // more errors occurred than could be stored
+    const FieldSchema* schema;      // resolves fieldIndex to a name
+
+    StructaErrorList() : count(0), truncated(false), schema(nullptr) {}
+
+    void clear() { count = 0; truncated = false; }
+    bool empty() const { return count == 0; }
+
+    void add(size_t fieldIndex, SerializationError code, const char* message) {
+        if (count >= STRUCTA_MAX_ERRORS) { truncated = true; return; }
+        StructaFieldError& e = errors[count++];
+        e.fieldIndex = fieldIndex < StructaFieldError::NO_FIELD ? (uint8_t)fieldIndex : StructaFieldError::NO_FIELD;
+        e.code = code;
+        e.message = message;
+    }
+
+    // Points into flash when STRUCTA_USE_PROGMEM is set
+    const char* fieldName(size_t i) const {
+        uint8_t idx = errors[i].fieldIndex;
+        return (schema && idx != StructaFieldError::NO_FIELD) ? structaLoadSchema(schema + idx).name : nullptr;
+    }
+
+    ErrorInfo get(size_t i) const {
+        const char* name = fieldName(i);
+        return ErrorInfo(errors[i].code, errors[i].message, name ? String(STRUCTA_FLASH(name)) : String());
+    }
+
+    String toString() const {
+        if (count == 0) return "Success";
+        String result;
+        for (size_t i = 0; i < count; ++i) {
+            if (i) result += "\n";
+            result += get(i).toString();
+        }
+        if (truncated) result += "\n(more errors omitted)";
+        return result;
+    }
+};
+
+// Returns check's failure from the enclosing function as a Result. Only
+// types that declare rules run it; their HAS_RULES is a compile-time constant.
+#define STRUCTA_CHECK_RULES(T, Result, check)                                \
+    if (T::HAS_RULES) {                                                      \
+        SerializationResult<void> checked = (check);                         \
+        if (!checked.success) {                                              \
+            return Result::Failure(checked.error.code, checked.error.message, checked.error.fieldPath); \
+        }                                                                    \
+    }
+#else
+#define STRUCTA_CHECK_RULES(T, Result, check)
+#endif // STRUCTA_VALIDATION
+
+// ======================================================
+// Document Capacity
+// ======================================================
+#ifndef STRUCTA_DEFAULT_STRING_SIZE
+#define STRUCTA_DEFAULT_STRING_SIZE 32   // expected length of a String field
+#endif
+
+#ifndef STRUCTA_MAX_STACK_DOCUMENT
+#define STRUCTA_MAX_STACK_DOCUMENT 512   // larger documents go on the heap
+#endif
+
+// Pool bytes a field needs on top of its own slot
+template<typename T, bool nested = HasSerialize<T>::value>
+struct StructaFieldCapacity {
+    static constexpr size_t get(size_t) { return 0; }
+};
+template<typename T> struct StructaFieldCapacity<T, true> {
+    static constexpr size_t get(size_t) { return T::jsonCapacity; }
+};
+template<> struct StructaFieldCapacity<String, false> {
+    static constexpr size_t get(size_t stringSize) { return JSON_STRING_SIZE(stringSize); }
+};
+template<> struct StructaFieldCapacity<const char*, false> {
+    static constexpr size_t get(size_t stringSize) { return JSON_STRING_SIZE(stringSize); }
+};
+// Arrays: one slot per element plus each element's own needs; a String hint
+// applies to every element
+template<typename T, size_t N> struct StructaFieldCapacity<T[N], false> {
+    static constexpr size_t get(size_t hint) { return JSON_ARRAY_SIZE(N) + N * StructaFieldCapacity<T>::get(hint); }
+};
+template<typename T, size_t N> struct StructaFieldCapacity<StructaArray<T, N>, false> {
+    static constexpr size_t get(size_t hint) { return StructaFieldCapacity<T[N]>::get(hint); }
+};
+// Parsed text is copied into the pool; the longest name or the capacity
+// bounds it, so these need no size hint
+template<typename E> struct StructaFieldCapacity<StructaEnum<E>, false> {
+    static constexpr size_t get(size_t) { return JSON_STRING_SIZE(E::LONGEST_NAME); }
+};
+template<size_t N> struct StructaFieldCapacity<StructaFixedString<N>, false> {
+    static constexpr size_t get(size_t) { return JSON_STRING_SIZE(N); }
+};
+// META_FIXED text is copied into the pool
+template<typename T, int32_t Scale, uint8_t Decimals>
+struct StructaFieldCapacity<StructaScaled<T, Scale, Decimals>, false> {
+    typedef StructaScaled<T, Scale, Decimals> View;
+    static constexpr size_t get(size_t) { return Decimals ? JSON_STRING_SIZE(View::TEXT_SIZE - 1) : 0; }
+};
+
+// Pool bytes a field's entry in the inbound filter needs beyond its own slot
+// and key (see STRUCTA_KEY_SIZE)
+template<typename T, bool nested = HasSerialize<T>::value>
+struct StructaFilterCapacity {
+    static constexpr size_t get() { return 0; }
+};
+template<typename T> struct StructaFilterCapacity<T, true> {
+    static constexpr size_t get() { return T::filterCapacity; }
+};
+// Arrays of structs filter their elements through a one-element array
+template<typename T, size_t N> struct StructaFilterCapacity<T[N], false> {
+    static constexpr size_t get() { return HasSerialize<T>::value ? JSON_ARRAY_SIZE(1) + StructaFilterCapacity<T>::get() : 0; }
+};
+template<typename T, size_t N> struct StructaFilterCapacity<StructaArray<T, N>, false> {
+    static constexpr size_t get() { return StructaFilterCapacity<T[N]>::get(); }
+};
+
+// Whether a member holds META_FIXED text somewhere in the document: in a
+// nested struct or in the structs of an array
+template<typename T, bool nested = HasSerialize<T>::value>
+struct StructaHasFixedText {
+    static constexpr bool value = false;
+};
+template<typename T> struct StructaHasFixedText<T, true> {
+    static constexpr bool value = T::HAS_FIXED_TEXT;
+};
+template<typename T, size_t N> struct StructaHasFixedText<T[N], false> {
+    static constexpr bool value = StructaHasFixedText<T>::value;
+};
+template<typename T, size_t N> struct StructaHasFixedText<StructaArray<T, N>, false> {
+    static constexpr bool value = StructaHasFixedText<T>::value;
+};
+
+// Fixed-capacity document; stack or heap is chosen at compile time
+template<size_t N, bool onStack = (N <= STRUCTA_MAX_STACK_DOCUMENT)>
+class StructaDocument : public StaticJsonDocument<N> {};
+template<size_t N>
+class StructaDocument<N, false> : public DynamicJsonDocument {
+public:
+    StructaDocument() : DynamicJsonDocument(N) {}
+};
+
+// ======================================================
+// Document Reuse
+// ======================================================
+// A StructaContext owns a document (and an output String) that the generated
+// methods reuse instead of building a fresh document per call, so a steady
+// encode/decode loop never touches the heap once warm. Declare contexts and
+// pools with static storage; a context serves one call at a time.
+class StructaContext {
+public:
+    JsonDocument& document() { return doc_; }
+    String& output() { return output_; }
+    size_t capacity() const { return doc_.capacity(); }
+
+protected:
+    explicit StructaContext(JsonDocument& doc) : doc_(doc) {}
+
+private:
+    StructaContext(const StructaContext&);
+    StructaContext& operator=(const StructaContext&);
+
+    JsonDocument& doc_;
+    String output_;
+};
+
+template<size_t Capacity>
+struct StructaContextStorage {
+    StructaDocument<Capacity> storage;
+};
+
+// Context with a document of Capacity bytes, e.g. StructaFixedContext<Telemetry::jsonCapacity>
+template<size_t Capacity>
+class StructaFixedContext : private StructaContextStorage<Capacity>, public StructaContext {
+public:
+    StructaFixedContext() : StructaContext(this->storage) {}
+};
+
+// Count preallocated contexts shared between tasks; acquire() returns
+// nullptr when all are in use
+template<size_t Count, size_t Capacity>
+class StructaDocumentPool {
+public:
+    StructaDocumentPool() {
+        for (size_t i = 0; i < Count; ++i) inUse_[i] = false;
+    }
+
+    StructaContext* acquire() {
+        StructaLock lock;
+        for (size_t i = 0; i < Count; ++i) {
+            if (!inUse_[i]) {
+                inUse_[i] = true;
+                return &contexts_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void release(StructaContext* context) {
+        StructaLock lock;
+        for (size_t i = 0; i < Count; ++i) {
+            if (&contexts_[i] == context) inUse_[i] = false;
+        }
+    }
+
+    size_t available() const {
+        StructaLock lock;
+        size_t n = 0;
+        for (size_t i = 0; i < Count; ++i) if (!inUse_[i]) ++n;
+        return n;
+    }
+
+private:
+    StructaFixedContext<Capacity> contexts_[Count];
+    bool inUse_[Count];
+};
+
+// ======================================================
+// Wire Formats
+// ======================================================
+// Each policy writes a filled document and parses input into one, so the
+// generated methods share one body for JSON and MessagePack.
+
+#ifndef STRUCTA_SCHEMA_VERSION
+#define STRUCTA_SCHEMA_VERSION 1   // first element of compact frames; bump to refuse older peers outright
+#endif
+// Formats that write META_FIXED's decimal text as it is; any other gets the
+// value as a number, since raw text would be copied into its output verbatim
+template<typename Format>
+struct StructaWritesText : std::false_type {};
+
+struct StructaJsonFormat {
+    // 0 if the buffer cannot hold the whole output
+    static size_t write(const JsonDocument& doc, char* buffer, size_t size) {
+        size_t written = size > 0 ? serializeJson(doc, buffer, size) : 0;
+        // A full buffer is either an exact fit or a truncation; only then measure
+        if (written == 0 || (written + 1 >= size && measureJson(doc) >= size)) return 0;
+        return written;
+    }
+    static size_t write(const JsonDocument& doc, Print& out) { return serializeJson(doc, out); }
+    static size_t measure(const JsonDocument& doc) { return measureJson(doc); }
+
+    // Batches are [item,item,...]
+    static size_t beginBatch(Print& out, size_t) { return out.print('['); }
+    static size_t nextItem(Print& out) { return out.print(','); }
+    static size_t endBatch(Print& out) { return out.print(']'); }
+
+    static DeserializationError read(JsonDocument& doc, const String& input) { return deserializeJson(doc, input); }
+    static DeserializationError read(JsonDocument& doc, const char* input) { return deserializeJson(doc, input); }
+    static DeserializationError read(JsonDocument& doc, const uint8_t* input, size_t length) { return deserializeJson(doc, input, length); }
+    static DeserializationError read(JsonDocument& doc, char* input, size_t length) { return deserializeJson(doc, input, length); }
+    static DeserializationError read(JsonDocument& doc, Stream& in) { return deserializeJson(doc, in); }
+
+    // Same, keeping only the keys present in filter
+    static DeserializationError read(JsonDocument& doc, const String& input, const JsonDocument& filter) {
+        return deserializeJson(doc, input, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, const char* input, const JsonDocument& filter) {
+        return deserializeJson(doc, input, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, const uint8_t* input, size_t length, const JsonDocument& filter) {
+        return deserializeJson(doc, input, length, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, char* input, size_t length, const JsonDocument& filter) {
+        return deserializeJson(doc, input, length, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, Stream& in, const JsonDocument& filter) {
+        return deserializeJson(doc, in, DeserializationOption::Filter(filter));
+    }
+};
+
+template<>
+struct StructaWritesText<StructaJsonFormat> : std::true_type {};
+
+struct StructaMsgPackFormat {
+    static size_t write(const JsonDocument& doc, char* buffer, size_t size) {
+        if (measureMsgPack(doc) > size) return 0;
+        return serializeMsgPack(doc, buffer, size);
+    }
+    static size_t write(const JsonDocument& doc, Print& out) { return serializeMsgPack(doc, out); }
+    static size_t measure(const JsonDocument& doc) { return measureMsgPack(doc); }
+
+    // Batches are an array header for count items, then the items
+    static size_t beginBatch(Print& out, size_t count) {
+        uint8_t header[5];
+        size_t length;
+        if (count < 16) {
+            header[0] = (uint8_t)(0x90 | count);
+            length = 1;
+        } else if (count <= 0xFFFF) {
+            header[0] = 0xDC;
+            header[1] = (uint8_t)(count >> 8);
+            header[2] = (uint8_t)count;
+            length = 3;
+        } else {
+            header[0] = 0xDD;
+            for (int i = 0; i < 4; ++i) header[1 + i] = (uint8_t)((uint32_t)count >> (24 - 8 * i));
+            length = 5;
+        }
+        return out.write(header, length);
+    }
+    static size_t nextItem(Print&) { return 0; }
+    static size_t endBatch(Print&) { return 0; }
+
+    static DeserializationError read(JsonDocument& doc, const uint8_t* input, size_t length) { return deserializeMsgPack(doc, input, length); }
+    static DeserializationError read(JsonDocument& doc, char* input, size_t length) { return deserializeMsgPack(doc, input, length); }
+    static DeserializationError read(JsonDocument& doc, Stream& in) { return deserializeMsgPack(doc, in); }
+
+    static DeserializationError read(JsonDocument& doc, const uint8_t* input, size_t length, const JsonDocument& filter) {
+        return deserializeMsgPack(doc, input, length, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, char* input, size_t length, const JsonDocument& filter) {
+        return deserializeMsgPack(doc, input, length, DeserializationOption::Filter(filter));
+    }
+    static DeserializationError read(JsonDocument& doc, Stream& in, const JsonDocument& filter) {
+        return deserializeMsgPack(doc, in, DeserializationOption::Filter(filter));
+    }
+};
+
+// ======================================================
+// Direct Parser
+// ======================================================
+// Pull tokenizer used by deserializeDirect(): values are decoded straight
+// into the struct's members as they are read, with no JsonDocument and so
+// no capacity limit. Stack use is fixed (one key buffer per nesting level
+// of the struct) and unknown values, however deep, are skipped iteratively.
+// A value of the wrong JSON type is skipped and the member left as is.
+#ifndef STRUCTA_MAX_KEY_LENGTH
+#define STRUCTA_MAX_KEY_LENGTH 31   // longest field name the direct parser matches
+#endif
+
+class StructaReader {
+public:
+    typedef char Key[STRUCTA_MAX_KEY_LENGTH + 1];
+
+    StructaReader(const char* input, size_t length)
+        : p_(input), end_(input + length), stream_(nullptr), lookahead_(NONE), error_(nullptr) {}
+    explicit StructaReader(Stream& input)
+        : p_(nullptr), end_(nullptr), stream_(&input), lookahead_(NONE), error_(nullptr) {}
+
+    bool ok() const { return error_ == nullptr; }
+    const char* error() const { return error_; }
+    const char* position() const { return p_; }   // buffer input only
+
+    bool beginObject() { return expect('{'); }
+
+    // Moves to the next member and reads its key; false once the closing
+    // brace is consumed or on error. Over-long keys come back empty.
+    bool nextMember(Key& key, bool& first) {
+        if (!nextItem('}', first)) return false;
+        if (peekToken() != '"') return fail("Expected key");
+        KeySink sink(key);
+        if (!readQuoted(sink)) return false;
+        return expect(':');
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type
+    read(T& value) {
+        if (!startsNumber()) return skipValue();
+        char token[32];
+        if (!readNumber(token, sizeof(token))) return false;
+        value = (T)parseInteger(token);
+        return true;
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+    read(T& value) {
+        if (!startsNumber()) return skipValue();
+        char token[32];
+        double parsed;
+        if (!readNumber(token, sizeof(token)) || !parseDouble(token, parsed)) return false;
+        value = (T)parsed;
+        return true;
+    }
+
+    // Encoded floats are parsed into their scaled integer without strtod
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    bool read(StructaScaled<T, Scale, Decimals> value) {
+        if (!startsNumber()) return skipValue();
+        char token[32];
+        if (!readNumber(token, sizeof(token))) return false;
+        value.setRaw(Decimals == 0 ? (long)parseInteger(token) : parseFixed(token, Decimals));
+        return true;
+    }
+
+    bool read(bool& value) {
+        int c = peekToken();
+        if (c == 't') { value = true; return readLiteral("true"); }
+        if (c == 'f') { value = false; return readLiteral("false"); }
+        return skipValue();
+    }
+
+    // Refills the String in its existing buffer
+    bool read(String& value) {
+        if (peekToken() != '"') return skipValue();
+        value = "";
+        StringSink sink(value);
+        bool done = readQuoted(sink);
+        sink.flush();
+        return done;
+    }
+
+    // Characters beyond N are dropped
+    template<size_t N>
+    bool read(StructaFixedString<N>& value) {
+        if (peekToken() != '"') return skipValue();
+        TextSink sink(value.text, N);
+        return readQuoted(sink);
+    }
+
+    // The name is matched in a buffer as long as the longest one; anything
+    // longer cannot be in the set and leaves the member as it was
+    template<typename E>
+    bool read(StructaEnum<E>& value) {
+        if (peekToken() != '"') return skipValue();
+        char text[E::LONGEST_NAME + 1];
+        TextSink sink(text, E::LONGEST_NAME);
+        if (!readQuoted(sink)) return false;
+        if (!sink.overflow) value.parse(text);
+        return true;
+    }
+
+    template<typename T>
+    typename std::enable_if<HasSerialize<T>::value, bool>::type
+    read(T& value) {
+        if (peekToken() != '{') return skipValue();
+        return T::parseFields(*this, value);
+    }
+
+    // Extra elements beyond the array's capacity are skipped
+    template<typename T, size_t N>
+    bool read(T (&values)[N]) {
+        size_t count;
+        return readArray(values, N, count);
+    }
+
+    template<typename T, size_t N>
+    bool read(StructaArray<T, N>& values) {
+        size_t count;
+        if (!readArray(values.items, N, count)) return false;
+        if (count != NO_ARRAY) values.count = count;
+        return true;
+    }
+
+    bool skipValue() {
+        int depth = 0;
+        do {
+            int c = peekToken();
+            if (c == '"') {
+                NullSink sink;
+                if (!readQuoted(sink)) return false;
+            } else if (c == '{' || c == '[') {
+                get();
+                ++depth;
+            } else if ((c == '}' || c == ']' || c == ',' || c == ':') && depth > 0) {
+                get();
+                if (c == '}' || c == ']') --depth;
+            } else if (startsNumber()) {
+                char token[32];
+                if (!readNumber(token, sizeof(token))) return false;
+            } else if (c == 't') {
+                if (!readLiteral("true")) return false;
+            } else if (c == 'f') {
+                if (!readLiteral("false")) return false;
+            } else if (c == 'n') {
+                if (!readLiteral("null")) return false;
+            } else {
+                return fail(c < 0 ? "Incomplete input" : "Invalid input");
+            }
+        } while (depth > 0);
+        return true;
+    }
+
+private:
+    static const int NONE = -2;
+    static const size_t NO_ARRAY = (size_t)-1;
+
+    struct KeySink {
+        char* key;
+        size_t length;
+        bool overflow;
+        explicit KeySink(Key& k) : key(k), length(0), overflow(false) { key[0] = '\0'; }
+        void put(char c) {
+            if (length < STRUCTA_MAX_KEY_LENGTH) { key[length++] = c; key[length] = '\0'; }
+            else { overflow = true; key[0] = '\0'; }
+        }
+    };
+
+    // Buffers characters so the String grows a chunk at a time
+    struct StringSink {
+        String& out;
+        char chunk[32];
+        size_t length;
+        explicit StringSink(String& s) : out(s), length(0) {}
+        void put(char c) {
+            chunk[length++] = c;
+            if (length == sizeof(chunk) - 1) flush();
+        }
+        void flush() {
+            chunk[length] = '\0';
+            if (length) out += chunk;
+            length = 0;
+        }
+    };
+
+    // Fills a buffer of capacity characters plus the NUL
+    struct TextSink {
+        char* text;
+        size_t capacity;
+        size_t length;
+        bool overflow;
+        TextSink(char* buffer, size_t size) : text(buffer), capacity(size), length(0), overflow(false) { text[0] = '\0'; }
+        void put(char c) {
+            if (length < capacity) { text[length++] = c; text[length] = '\0'; }
+            else overflow = true;
+        }
+    };
+
+    struct NullSink {
+        void put(char) {}
+    };
+
+    int peek() {
+        if (!stream_) return p_ < end_ ? (uint8_t)*p_ : -1;
+        if (lookahead_ == NONE) {
+            char c;
+            lookahead_ = stream_->readBytes(&c, 1) == 1 ? (uint8_t)c : -1;   // honours the stream timeout
+        }
+        return lookahead_;
+    }
+
+    int get() {
+        int c = peek();
+        if (stream_) lookahead_ = NONE;
+        else if (c >= 0) ++p_;
+        return c;
+    }
+
+    int peekToken() {
+        int c = peek();
+        while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            get();
+            c = peek();
+        }
+        return c;
+    }
+
+    bool fail(const char* message) {
+        if (!error_) error_ = message;
+        return false;
+    }
+
+    bool expect(char c) {
+        if (peekToken() != c) return fail("Unexpected character");
+        get();
+        return true;
+    }
+
+    // Consumes the separator before the next item, or the closing bracket
+    bool nextItem(char close, bool& first) {
+        int c = peekToken();
+        if (c == close) { get(); return false; }
+        if (!first) {
+            if (c != ',') return fail("Expected ','");
+            get();
+        }
+        first = false;
+        return ok();
+    }
+
+    template<typename T>
+    bool readArray(T* values, size_t capacity, size_t& count) {
+        count = NO_ARRAY;
+        if (peekToken() != '[') return skipValue();
+        get();
+        count = 0;
+        bool first = true;
+        while (nextItem(']', first)) {
+            bool readOk = count < capacity ? read(values[count++]) : skipValue();
+            if (!readOk) return false;
+        }
+        return ok();
+    }
+
+    bool startsNumber() {
+        int c = peekToken();
+        return c == '-' || (c >= '0' && c <= '9');
+    }
+
+    // One JSON number: an optional '-', digits, an optional fraction and an
+    // optional exponent. Text that runs on into another number character
+    // (1-2, 1.2.3, --1) is rejected rather than cut short.
+    bool readNumber(char* token, size_t size) {
+        size_t n = 0;
+        if (peek() == '-' && !take(token, n, size)) return false;
+        if (!takeDigits(token, n, size)) return false;
+        if (peek() == '.' && (!take(token, n, size) || !takeDigits(token, n, size))) return false;
+        int c = peek();
+        if (c == 'e' || c == 'E') {
+            if (!take(token, n, size)) return false;
+            c = peek();
+            if ((c == '+' || c == '-') && !take(token, n, size)) return false;
+            if (!takeDigits(token, n, size)) return false;
+        }
+        c = peek();
+        if (c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') return fail("Invalid number");
+        token[n] = '\0';
+        return true;
+    }
+
+    bool take(char* token, size_t& n, size_t size) {
+        if (n + 1 >= size) return fail("Number too long");
+        token[n++] = (char)get();
+        return true;
+    }
+
+    // At least one digit
+    bool takeDigits(char* token, size_t& n, size_t size) {
+        int c = peek();
+        if (c < '0' || c > '9') return fail("Invalid number");
+        while (c >= '0' && c <= '9') {
+            if (!take(token, n, size)) return false;
+            c = peek();
+        }
+        return true;
+    }
+
+    // strtod on a token readNumber accepted; anything it leaves unread fails
+    bool parseDouble(const char* token, double& value) {
+        char* end;
+        value = strtod(token, &end);
+        return *end == '\0' || fail("Invalid number");
+    }
+
+    static long long parseInteger(const char* token) {
+        for (const char* s = token; *s; ++s) {
+            if (*s == '.' || *s == 'e' || *s == 'E') return (long long)strtod(token, nullptr);
+        }
+        bool negative = *token == '-';
+        unsigned long long v = 0;
+        for (const char* s = token + (negative ? 1 : 0); *s; ++s) v = v * 10 + (*s - '0');
+        return negative ? -(long long)v : (long long)v;
+    }
+
+    // Decimal text in units of 10^-decimals, rounded half away from zero on
+    // the first digit dropped; only exponents fall back to strtod
+    static long parseFixed(const char* token, uint8_t decimals) {
+        for (const char* s = token; *s; ++s) {
+            if (*s == 'e' || *s == 'E') {
+                return structaRoundScaled(strtod(token, nullptr) * structaPow10(decimals));
+            }
+        }
+        bool negative = *token == '-';
+        const char* s = token + (negative ? 1 : 0);
+        unsigned long v = 0;
+        for (; *s >= '0' && *s <= '9'; ++s) v = v * 10 + (*s - '0');
+        uint8_t digits = 0;
+        if (*s == '.') {
+            for (++s; *s >= '0' && *s <= '9' && digits < decimals; ++s, ++digits) v = v * 10 + (*s - '0');
+        }
+        for (; digits < decimals; ++digits) v *= 10;
+        if (*s >= '5' && *s <= '9') ++v;
+        return negative ? -(long)v : (long)v;
+    }
+
+    bool readLiteral(const char* word) {
+        for (const char* w = word; *w; ++w) {
+            if (get() != *w) return fail("Invalid literal");
+        }
+        return true;
+    }
+
+    static int hexValue(int c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool readHex4(uint32_t& cp) {
+        cp = 0;
+        for (int i = 0; i < 4; ++i) {
+            int h = hexValue(get());
+            if (h < 0) return fail("Invalid escape");
+            cp = (cp << 4) | (uint32_t)h;
+        }
+        return true;
+    }
+
+    template<typename Sink>
+    static void putUtf8(Sink& sink, uint32_t cp) {
+        if (cp < 0x80) {
+            sink.put((char)cp);
+        } else if (cp < 0x800) {
+            sink.put((char)(0xC0 | (cp >> 6)));
+            sink.put((char)(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            sink.put((char)(0xE0 | (cp >> 12)));
+            sink.put((char)(0x80 | ((cp >> 6) & 0x3F)));
+            sink.put((char)(0x80 | (cp & 0x3F)));
+        } else {
+            sink.put((char)(0xF0 | (cp >> 18)));
+            sink.put((char)(0x80 | ((cp >> 12) & 0x3F)));
+            sink.put((char)(0x80 | ((cp >> 6) & 0x3F)));
+            sink.put((char)(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    // Reads a quoted string (at the opening quote), resolving escapes
+    template<typename Sink>
+    bool readQuoted(Sink& sink) {
+        get();
+        while (true) {
+            int c = get();
+            if (c < 0) return fail("Unterminated string");
+            if (c == '"') return true;
+            if (c != '\\') { sink.put((char)c); continue; }
+            int e = get();
+            switch (e) {
+                case '"': case '\\': case '/': sink.put((char)e); break;
+                case 'b': sink.put('\b'); break;
+                case 'f': sink.put('\f'); break;
+                case 'n': sink.put('\n'); break;
+                case 'r': sink.put('\r'); break;
+                case 't': sink.put('\t'); break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!readHex4(cp)) return false;
+                    if (cp >= 0xD800 && cp < 0xDC00) {
+                        // Surrogate pair; the second half must be a low surrogate
+                        uint32_t low;
+                        if (get() != '\\' || get() != 'u' || !readHex4(low)) return fail("Invalid escape");
+                        if (low < 0xDC00 || low > 0xDFFF) return fail("Invalid surrogate pair");
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return fail("Invalid surrogate pair");
+                    }
+                    putUtf8(sink, cp);
+                    break;
+                }
+                default: return fail("Invalid escape");
+            }
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+    Stream* stream_;
+    int lookahead_;
+    const char* error_;
+};
+
+// ======================================================
+// Field Descriptors
+// ======================================================
+// Every struct also describes its fields in a constant table: name, key
+// hash, offset and kind, the element layout of arrays and a pointer to a
+// nested struct's own table. The engine in JsonStruct walks these tables for
+// serializeInto(), deserializeFields(), the delta helpers and buildFilter(),
+// so that code exists once in the binary instead of once per struct.
+// With STRUCTA_USE_PROGMEM the tables and their names live in flash.
+//
+// STRUCTA_INLINE_FIELDS 1 expands those methods field by field instead,
+// which is faster for structs on a hot path. It is read where each DEFINE_*
+// macro is used, so it can be switched on for a single struct:
+//   #undef STRUCTA_INLINE_FIELDS
+//   #define STRUCTA_INLINE_FIELDS 1
+//   DEFINE_STRUCTA(Telemetry, TELEMETRY_FIELDS)
+#ifndef STRUCTA_INLINE_FIELDS
+#define STRUCTA_INLINE_FIELDS 0
+#endif
+
+// Member offsets are taken with offsetof, which GCC flags for structs that
+// are not standard-layout; the generated structs have no virtual members or
+// virtual bases, so the offsets are fixed
+#if defined(__GNUC__)
+#define STRUCTA_OFFSETS_BEGIN                                                \
+    _Pragma("GCC diagnostic push")                                           \
+    _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"")
+#define STRUCTA_OFFSETS_END _Pragma("GCC diagnostic pop")
+#else
+#define STRUCTA_OFFSETS_BEGIN
+#define STRUCTA_OFFSETS_END
+#endif
+
+struct StructaDescriptor;
+struct StructaFieldOps;
+
+struct StructaField {
+    enum Kind : uint8_t {
+        KIND_BOOL, KIND_INT8, KIND_UINT8, KIND_INT16, KIND_UINT16, KIND_INT32, KIND_UINT32,
+        KIND_FLOAT, KIND_DOUBLE, KIND_STRING, KIND_CSTR,
+        KIND_OBJECT,    // nested struct, described by nested()
+        KIND_ARRAY,     // T[N]: capacity elements of kind element, stride bytes apart
+        KIND_LIST,      // StructaArray<T, N>: the same, with its size_t count at countOffset
+        KIND_CUSTOM     // any other type (64-bit integers, arrays of arrays...), through ops
+    };
+
+    uint16_t nameAt;        // offset of the name in the struct's names block
+    uint16_t offset;        // offsetof the member
+    uint32_t hash;          // StructaKey::hash of the name
+    uint8_t kind;
+    uint8_t element;        // element kind of KIND_ARRAY / KIND_LIST
+    uint16_t capacity;
+    uint16_t stride;
+    uint16_t countOffset;
+    const StructaDescriptor& (*nested)();   // table of an object or object element
+    const StructaFieldOps* ops;             // KIND_CUSTOM handlers
+};
+
+struct StructaDescriptor {
+    const char* names;      // each field name, NUL-terminated, in FIELD_LIST order
+    const StructaField* fields;
+    uint8_t count;
+
+    StructaField field(uint8_t i) const {
+#if STRUCTA_USE_PROGMEM
+        StructaField f;
+        memcpy_P(&f, fields + i, sizeof(f));
+        return f;
+#else
+        return fields[i];
+#endif
+    }
+
+    uint32_t hash(uint8_t i) const {
+#if STRUCTA_USE_PROGMEM
+        return pgm_read_dword(&fields[i].hash);
+#else
+        return fields[i].hash;
+#endif
+    }
+
+    StructaKeyText key(const StructaField& f) const { return STRUCTA_FLASH(names + f.nameAt); }
+};
+
+// Per-type handlers for KIND_CUSTOM; the templated JsonStruct helpers do the work
+struct StructaFieldOps {
+    void (*write)(JsonObject& obj, StructaKeyText key, const void* value);
+    void (*read)(JsonVariant v, void* value);
+    bool (*same)(const void* a, const void* b);
+    void (*filter)(JsonObject& filter, StructaKeyText key);
+};
+
+// ======================================================
+// Schema Fingerprint
+// ======================================================
+// Each struct has a schemaHash computed at compile time from its FIELD_LIST:
+// every field's name and the kind of value it puts in a compact frame, in
+// order, with nested structs contributing their own schemaHash. Compact
+// frames carry it after STRUCTA_SCHEMA_VERSION, so a reader knows whether
+// the writer's fields line up with its own before decoding any of them.
+// Only what the frame shows counts: int to long keeps the hash; a rename,
+// a new or reordered field, or a float becoming META_SCALED changes it.
+//
+// A frame with the reader's own hash is decoded by position as before. Any
+// other hash needs the writer's field list, which it sends once with
+// serializeSchema(). A StructaSchemaCache keeps, per writer hash, which
+// local field each element fills, and frames with that hash then decode
+// through the table: elements the reader has no field of that kind for are
+// skipped, and fields the writer lacks keep their defaults. A nested struct
+// whose schema differs is skipped as a whole.
+//   static StructaSchemaCache<Telemetry> peers;
+//   peers.learn(description, length);         // once per peer firmware
+//   auto r = Telemetry::deserializeCompact(frame, length, peers);
+
+// Kind of value a member puts in a compact frame
+template<typename T, bool nested = HasSerialize<T>::value>
+struct StructaTypeHash {
+    static constexpr uint32_t value = std::is_same<T, bool>::value ? 'b'
+                                    : std::is_floating_point<T>::value ? 'f'
+                                    : std::is_integral<T>::value ? 'i'
+                                    : 's';   // String, const char* and other text
+};
+template<typename T> struct StructaTypeHash<T, true> {
+    static constexpr uint32_t value = T::schemaHash;
+};
+template<typename T, size_t N> struct StructaTypeHash<T[N], false> {
+    static constexpr uint32_t value = structaMix('a', StructaTypeHash<T>::value);
+};
+template<typename T, size_t N> struct StructaTypeHash<StructaArray<T, N>, false> {
+    static constexpr uint32_t value = structaMix('a', StructaTypeHash<T>::value);
+};
+template<typename E> struct StructaTypeHash<StructaEnum<E>, false> {
+    static constexpr uint32_t value = structaMix('e', E::NAMES_HASH);
+};
+template<size_t N> struct StructaTypeHash<StructaFixedString<N>, false> {
+    static constexpr uint32_t value = 's';
+};
+template<typename T, int32_t Scale, uint8_t Decimals> struct StructaTypeHash<StructaScaled<T, Scale, Decimals>, false> {
+    static constexpr uint32_t value = structaMix('d', (uint32_t)Scale);
+};
+
+// Which local field each element of a peer's frame fills
+struct StructaFieldMap {
+    enum { SKIP = 0xFF };
+    const uint8_t* field;       // nullptr when the peer's schema is unknown
+    size_t count;
+
+    StructaFieldMap(const uint8_t* fields = nullptr, size_t n = 0) : field(fields), count(n) {}
+};
+
+// Peers for frames decoded without a cache: only the reader's own schema
+template<typename T>
+struct StructaNoPeers {
+    typedef typename T::CompactDocument FrameDocument;
+    StructaFieldMap find(uint32_t) const { return StructaFieldMap(); }
+};
+
+// Field tables for up to Peers writer schemas of T, each with up to
+// MaxFields fields. Learning a schema beyond Peers replaces the oldest.
+// A peer's frames may hold more than T's, so they are parsed into a
+// document of FrameCapacity bytes, by default twice T's own. The cache is
+// not locked; learn before decoding on other tasks.
+template<typename T, size_t Peers = 4, size_t MaxFields = 32, size_t FrameCapacity = 2 * T::compactCapacity>
+class StructaSchemaCache {
+public:
+    static_assert(Peers > 0 && MaxFields > 0, "StructaSchemaCache needs room for a schema");
+    static_assert((int)T::FIELD_COUNT < (int)StructaFieldMap::SKIP, "Schema tables index at most 254 fields");
+    typedef StructaDocument<FrameCapacity> FrameDocument;
+
+    StructaSchemaCache() : count_(0), next_(0) {}
+
+    // Reads a peer's serializeSchema() output
+    template<typename Format = StructaJsonFormat>
+    SerializationResult<void> learn(const uint8_t* input, size_t length) {
+        StructaDocument<JSON_ARRAY_SIZE(2 + 2 * MaxFields)> doc;
+        DeserializationError err = Format::read(doc, input, length);
+        if (err == DeserializationError::NoMemory) {
+            return SerializationResult<void>::Failure(SerializationError::BUFFER_OVERFLOW, "Peer schema too large");
+        }
+        if (err) {
+            return SerializationResult<void>::Failure(SerializationError::INVALID_JSON, String("Parse error: ") + err.c_str());
+        }
+        return learn(doc.template as<JsonArray>());
+    }
+
+    // [STRUCTA_SCHEMA_VERSION, schemaHash, name hash, kind, name hash, kind, ...]
+    SerializationResult<void> learn(const JsonArray& description) {
+        JsonArray::iterator it = description.begin();
+        JsonArray::iterator end = description.end();
+        if (!(it != end) || (*it).as<int>() != STRUCTA_SCHEMA_VERSION) {
+            return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, "Schema version mismatch");
+        }
+        ++it;
+        if (!(it != end)) {
+            return SerializationResult<void>::Failure(SerializationError::INVALID_JSON, "Not a schema description");
+        }
+        Entry entry;
+        entry.hash = (*it).as<uint32_t>();
+        entry.count = 0;
+        if (entry.hash == T::schemaHash) return SerializationResult<void>::Success();   // decoded by position
+        for (++it; it != end; ++it) {
+            uint32_t name = (*it).as<uint32_t>();
+            if (!(++it != end)) {
+                return SerializationResult<void>::Failure(SerializationError::INVALID_JSON, "Not a schema description");
+            }
+            if (entry.count == MaxFields) {
+                return SerializationResult<void>::Failure(SerializationError::BUFFER_OVERFLOW, "Peer schema too large");
+            }
+            int local = T::fieldIndexByHash(name);
+            bool same = local >= 0 && T::fieldKind(local) == (*it).as<uint32_t>();
+            entry.field[entry.count++] = same ? (uint8_t)local : (uint8_t)StructaFieldMap::SKIP;
+        }
+        slotFor(entry.hash) = entry;
+        return SerializationResult<void>::Success();
+    }
+
+    StructaFieldMap find(uint32_t hash) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].hash == hash) return StructaFieldMap(entries_[i].field, entries_[i].count);
+        }
+        return StructaFieldMap();
+    }
+
+    size_t size() const { return count_; }
+    void clear() { count_ = next_ = 0; }
+
+private:
+    struct Entry {
+        uint32_t hash;
+        size_t count;
+        uint8_t field[MaxFields];
+    };
+
+    Entry& slotFor(uint32_t hash) {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].hash == hash) return entries_[i];
+        }
+        if (count_ < Peers) return entries_[count_++];
+        Entry& oldest = entries_[next_];
+        next_ = (next_ + 1) % Peers;
+        return oldest;
+    }
+
+    Entry entries_[Peers];
+    size_t count_;
+    size_t next_;   // replaced next once every slot is taken
+};
+
+// ======================================================
+// Base Class
+// ======================================================
+class JsonStruct {
+protected:
+    // Serialize primitives
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    serializeField(JsonObject& obj, StructaKeyText key, const T& value) {
+        obj[key] = value;
+    }
+    
+    // Serialize nested structs straight into the parent's object tree
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    serializeField(JsonObject& obj, StructaKeyText key, const T& value) {
+        JsonObject child = obj.createNestedObject(key);
+        value.serializeInto(child);
+    }
+    
+    // Arrays: fixed-size arrays write every slot, StructaArray its used items
+    template<typename T, size_t N>
+    static void serializeField(JsonObject& obj, StructaKeyText key, const T (&values)[N]) {
+        JsonArray arr = obj.createNestedArray(key);
+        writeItems(arr, values, N);
+    }
+
+    template<typename T, size_t N>
+    static void serializeField(JsonObject& obj, StructaKeyText key, const StructaArray<T, N>& values) {
+        JsonArray arr = obj.createNestedArray(key);
+        writeItems(arr, values.items, values.count);
+    }
+
+    // Enum fields write their name; an index out of range is written as null
+    template<typename E>
+    static void serializeField(JsonObject& obj, StructaKeyText key, const StructaEnum<E>& value) {
+        if (value.valid()) obj[key] = STRUCTA_FLASH(value.name());
+        else obj[key] = (const char*)nullptr;
+    }
+
+    template<size_t N>
+    static void serializeField(JsonObject& obj, StructaKeyText key, const StructaFixedString<N>& value) {
+        obj[key] = value.c_str();
+    }
+
+    // The document's META_FIXED text, for formats that cannot carry it, as
+    // the number it stands for: nested structs and arrays of them recurse,
+    // keys a delta left out are skipped and every other member is left alone
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    fixedAsNumber(JsonObject&, StructaKeyText, const T&) {}
+
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void fixedAsNumber(JsonObject& obj, StructaKeyText key, const StructaScaled<T, Scale, Decimals>& value) {
+        if (Decimals > 0 && obj.containsKey(key)) obj[key] = (double)value.raw() / Scale;
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    fixedAsNumber(JsonObject& obj, StructaKeyText key, const T& value) {
+        if (!T::HAS_FIXED_TEXT) return;
+        JsonObject child = obj[key].template as<JsonObject>();
+        if (!child.isNull()) value.fixedAsNumbers(child);
+    }
+
+    template<typename T, size_t N>
+    static void fixedAsNumber(JsonObject& obj, StructaKeyText key, const T (&values)[N]) {
+        fixedItemsAsNumbers(obj, key, values, N);
+    }
+
+    template<typename T, size_t N>
+    static void fixedAsNumber(JsonObject& obj, StructaKeyText key, const StructaArray<T, N>& values) {
+        fixedItemsAsNumbers(obj, key, values.items, values.count);
+    }
+
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    fixedItemsAsNumbers(JsonObject&, StructaKeyText, const T*, size_t) {}
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    fixedItemsAsNumbers(JsonObject& obj, StructaKeyText key, const T* values, size_t count) {
+        if (!T::HAS_FIXED_TEXT) return;
+        JsonArray items = obj[key].template as<JsonArray>();
+        for (size_t i = 0; i < count && i < items.size(); ++i) {
+            JsonObject item = items[i].template as<JsonObject>();
+            if (!item.isNull()) values[i].fixedAsNumbers(item);
+        }
+    }
+
+    // Encoded floats: META_SCALED as an integer, META_FIXED as its decimal
+    // text, copied into the pool
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void serializeField(JsonObject& obj, StructaKeyText key, const StructaScaled<T, Scale, Decimals>& value) {
+        if (Decimals == 0) {
+            obj[key] = value.raw();
+        } else {
+            char text[StructaScaled<T, Scale, Decimals>::TEXT_SIZE];
+            size_t length = value.format(text);
+            obj[key] = serialized(text, length);
+        }
+    }
+
+    // Delta encoding: only members that differ from a snapshot are written.
+    // Nested structs write just their own changed members, arrays go whole.
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, bool>::type
+    sameValue(const T& a, const T& b) {
+        return a == b;
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, bool>::type
+    sameValue(const T& a, const T& b) {
+        return T::sameFields(a, b);
+    }
+
+    template<typename T, size_t N>
+    static bool sameValue(const T (&a)[N], const T (&b)[N]) {
+        return sameItems(a, b, N);
+    }
+
+    template<typename T, size_t N>
+    static bool sameValue(const StructaArray<T, N>& a, const StructaArray<T, N>& b) {
+        return a.count == b.count && sameItems(a.items, b.items, a.count);
+    }
+
+    template<typename T>
+    static bool sameItems(const T* a, const T* b, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!sameValue(a[i], b[i])) return false;
+        }
+        return true;
+    }
+
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    serializeChanged(JsonObject& obj, StructaKeyText key, const T& value, const T& since) {
+        if (!sameValue(value, since)) serializeField(obj, key, value);
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    serializeChanged(JsonObject& obj, StructaKeyText key, const T& value, const T& since) {
+        if (sameValue(value, since)) return;
+        JsonObject child = obj.createNestedObject(key);
+        value.serializeDeltaInto(child, since);
+    }
+
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void serializeChanged(JsonObject& obj, StructaKeyText key, const StructaScaled<T, Scale, Decimals>& value,
+                                 const typename StructaScaled<T, Scale, Decimals>::Value& since) {
+        if (!sameValue(value.value, since)) serializeField(obj, key, value);
+    }
+
+    // Lets the write helpers emit a delta like any other value
+    template<typename T>
+    struct Delta {
+        const T& value;
+        const T& since;
+        Delta(const T& current, const T& snapshot) : value(current), since(snapshot) {}
+        void serializeInto(JsonObject& obj) const { value.serializeDeltaInto(obj, since); }
+        enum { HAS_FIXED_TEXT = T::HAS_FIXED_TEXT };
+        void fixedAsNumbers(JsonObject& obj) const { value.fixedAsNumbers(obj); }
+        static MemoryTracker::TypeStats& memoryStats() { return T::memoryStats(); }
+#if STRUCTA_VALIDATION
+        enum { HAS_RULES = T::HAS_RULES };
+        SerializationResult<void> validateSelf() const { return value.validateSelf(); }
+#endif
+    };
+
+    // Inbound filter entries: true keeps a value whole, nested structs get
+    // their own object, and arrays of structs filter every element through
+    // the element's object. The pointer only selects the overload.
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    filterField(JsonObject& filter, StructaKeyText key, const T*) {
+        filter[key] = true;
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    filterField(JsonObject& filter, StructaKeyText key, const T*) {
+        JsonObject child = filter.createNestedObject(key);
+        T::buildFilter(child);
+    }
+
+    template<typename T, size_t N>
+    static void filterField(JsonObject& filter, StructaKeyText key, const T (*)[N]) {
+        filterItems(filter, key, static_cast<const T*>(nullptr));
+    }
+
+    template<typename T, size_t N>
+    static void filterField(JsonObject& filter, StructaKeyText key, const StructaArray<T, N>*) {
+        filterItems(filter, key, static_cast<const T*>(nullptr));
+    }
+
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    filterItems(JsonObject& filter, StructaKeyText key, const T*) {
+        filter[key] = true;
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    filterItems(JsonObject& filter, StructaKeyText key, const T*) {
+        JsonObject child = filter.createNestedArray(key).createNestedObject();
+        T::buildFilter(child);
+    }
+
+    template<typename T>
+    static bool fillFilter(JsonDocument& doc) {
+        JsonObject root = doc.to<JsonObject>();
+        T::buildFilter(root);
+        return !doc.overflowed();
+    }
+    
+    // Read one parsed value into a member; null leaves the member untouched
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    readField(JsonVariant v, T& value) {
+        if (!v.isNull()) value = v.as<T>();
+    }
+    
+    // Strings are assigned from the document's text, so a String whose
+    // capacity is already large enough is refilled without reallocating
+    static void readField(JsonVariant v, String& value) {
+        const char* text = v.as<const char*>();
+        if (text) value = text;
+        else if (!v.isNull()) value = v.as<String>();
+    }
+    
+    // Names outside the set leave an enum field as it was
+    template<typename E>
+    static void readField(JsonVariant v, StructaEnum<E>& value) {
+        const char* text = v.as<const char*>();
+        if (text) value.parse(text);
+    }
+
+    template<size_t N>
+    static void readField(JsonVariant v, StructaFixedString<N>& value) {
+        const char* text = v.as<const char*>();
+        if (text) value.assign(text);
+    }
+
+    // Nested structs are filled in place
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    readField(JsonVariant v, T& value) {
+        if (v.is<JsonObject>()) T::deserializeFields(v.as<JsonObject>(), value);
+    }
+
+    // META_SCALED takes the integer as is. META_FIXED text that parsed as an
+    // integer needs no float work; anything else is rounded to the declared
+    // decimals, so a value decodes the same here as through the direct parser.
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void readField(JsonVariant v, StructaScaled<T, Scale, Decimals> value) {
+        if (v.isNull()) return;
+        if (Decimals == 0) value.setRaw(v.as<long>());
+        else if (v.is<long>()) value.value = (T)v.as<long>();
+        else value.setRaw(structaRoundScaled(v.as<double>() * Scale));
+    }
+
+    // Extra elements beyond the array's capacity are ignored
+    template<typename T, size_t N>
+    static void readField(JsonVariant v, T (&values)[N]) {
+        JsonArray arr = v.as<JsonArray>();
+        if (!arr.isNull()) readItems(arr, values, N);
+    }
+
+    template<typename T, size_t N>
+    static void readField(JsonVariant v, StructaArray<T, N>& values) {
+        JsonArray arr = v.as<JsonArray>();
+        if (!arr.isNull()) values.count = readItems(arr, values.items, N);
+    }
+
+    // Look a single key up; missing keys leave the member untouched.
+    // Generated deserializeFields() walks the object once instead.
+    template<typename T>
+    static void deserializeField(const JsonObject& obj, StructaKeyText key, T& value) {
+        JsonVariant v = obj[key];
+        readField(v, value);
+    }
+
+    // Array items: values are added directly, nested structs as objects
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    writeItem(JsonArray& arr, const T& value) {
+        arr.add(value);
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    writeItem(JsonArray& arr, const T& value) {
+        JsonObject child = arr.createNestedObject();
+        value.serializeInto(child);
+    }
+
+    template<typename E>
+    static void writeItem(JsonArray& arr, const StructaEnum<E>& value) {
+        if (value.valid()) arr.add(STRUCTA_FLASH(value.name()));
+        else arr.add((const char*)nullptr);
+    }
+
+    template<size_t N>
+    static void writeItem(JsonArray& arr, const StructaFixedString<N>& value) {
+        arr.add(value.c_str());
+    }
+
+    template<typename T>
+    static void writeItems(JsonArray& arr, const T* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) writeItem(arr, values[i]);
+    }
+
+    // Returns the number of elements read
+    template<typename T>
+    static size_t readItems(const JsonArray& arr, T* values, size_t capacity) {
+        size_t count = 0;
+        for (JsonArray::iterator it = arr.begin(); it != arr.end() && count < capacity; ++it) {
+            readField(*it, values[count++]);
+        }
+        return count;
+    }
+
+    // Compact (positional) encoding: fields as array elements in FIELD_LIST order
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    serializeElement(JsonArray& arr, const T& value) {
+        arr.add(value);
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    serializeElement(JsonArray& arr, const T& value) {
+        JsonArray child = arr.createNestedArray();
+        value.serializeCompactInto(child);
+    }
+
+    // Array fields become a nested array of compact elements
+    template<typename T, size_t N>
+    static void serializeElement(JsonArray& arr, const T (&values)[N]) {
+        JsonArray child = arr.createNestedArray();
+        for (size_t i = 0; i < N; ++i) serializeElement(child, values[i]);
+    }
+
+    template<typename T, size_t N>
+    static void serializeElement(JsonArray& arr, const StructaArray<T, N>& values) {
+        JsonArray child = arr.createNestedArray();
+        for (size_t i = 0; i < values.count; ++i) serializeElement(child, values.items[i]);
+    }
+
+    // Enum fields are their index in compact frames
+    template<typename E>
+    static void serializeElement(JsonArray& arr, const StructaEnum<E>& value) {
+        arr.add(value.value);
+    }
+
+    template<size_t N>
+    static void serializeElement(JsonArray& arr, const StructaFixedString<N>& value) {
+        arr.add(value.c_str());
+    }
+
+    // Encoded floats are the scaled integer in compact frames
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void serializeElement(JsonArray& arr, const StructaScaled<T, Scale, Decimals>& value) {
+        arr.add(value.raw());
+    }
+
+    // Missing trailing elements and nulls leave the member untouched
+    template<typename T>
+    static typename std::enable_if<!HasSerialize<T>::value, void>::type
+    deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, T& value) {
+        if (!(it != end)) return;
+        JsonVariant v = *it;
+        if (!v.isNull()) value = v.as<T>();
+        ++it;
+    }
+    
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, String& value) {
+        if (!(it != end)) return;
+        JsonVariant v = *it;
+        const char* text = v.as<const char*>();
+        if (text) value = text;
+        else if (!v.isNull()) value = v.as<String>();
+        ++it;
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value, void>::type
+    deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, T& value) {
+        if (!(it != end)) return;
+        JsonArray sub = (*it).as<JsonArray>();
+        if (!sub.isNull()) T::deserializeCompactFields(sub.begin(), sub.end(), value);
+        ++it;
+    }
+
+    template<typename T, size_t N>
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, T (&values)[N]) {
+        if (!(it != end)) return;
+        JsonArray sub = (*it).as<JsonArray>();
+        if (!sub.isNull()) readElements(sub, values, N);
+        ++it;
+    }
+
+    template<typename T, size_t N>
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, StructaArray<T, N>& values) {
+        if (!(it != end)) return;
+        JsonArray sub = (*it).as<JsonArray>();
+        if (!sub.isNull()) values.count = readElements(sub, values.items, N);
+        ++it;
+    }
+
+    template<typename E>
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end, StructaEnum<E>& value) {
+        if (!(it != end)) return;
+        JsonVariant v = *it;
+        if (v.is<int>()) {
+            int index = v.as<int>();
+            if (index >= 0 && index < E::COUNT) value.value = (uint8_t)index;
+        }
+        ++it;
+    }
+
+    template<size_t N>
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end,
+                                   StructaFixedString<N>& value) {
+        if (!(it != end)) return;
+        const char* text = (*it).as<const char*>();
+        if (text) value.assign(text);
+        ++it;
+    }
+
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    static void deserializeElement(JsonArray::iterator& it, const JsonArray::iterator& end,
+                                   StructaScaled<T, Scale, Decimals> value) {
+        if (!(it != end)) return;
+        JsonVariant v = *it;
+        if (!v.isNull()) value.setRaw(v.as<long>());
+        ++it;
+    }
+
+    template<typename T>
+    static size_t readElements(const JsonArray& arr, T* values, size_t capacity) {
+        JsonArray::iterator it = arr.begin();
+        JsonArray::iterator end = arr.end();
+        size_t count = 0;
+        while (it != end && count < capacity) deserializeElement(it, end, values[count++]);
+        return count;
+    }
+
+    // Top-level frames are [STRUCTA_SCHEMA_VERSION, T::schemaHash, field0, field1, ...]
+    template<typename T>
+    static bool fillCompactDocument(JsonDocument& doc, const T& value) {
+        JsonArray arr = doc.to<JsonArray>();
+        arr.add(STRUCTA_SCHEMA_VERSION);
+        arr.add((uint32_t)T::schemaHash);
+        value.serializeCompactInto(arr);
+        return !doc.overflowed();
+    }
+
+    // Fills target from a frame: by position when it was written with T's
+    // schema, through the writer's field table when peers has one
+    template<typename T, typename Peers>
+    static SerializationResult<void> readCompactFrame(const JsonArray& arr, T& target, const Peers& peers) {
+        JsonArray::iterator it = arr.begin();
+        JsonArray::iterator end = arr.end();
+        if (!(it != end) || (*it).as<int>() != STRUCTA_SCHEMA_VERSION || !(++it != end)) {
+            return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, "Schema version mismatch");
+        }
+        uint32_t hash = (*it).as<uint32_t>();
+        ++it;
+        if (hash == T::schemaHash) {
+            T::deserializeCompactFields(it, end, target);
+            return SerializationResult<void>::Success();
+        }
+        StructaFieldMap map = peers.find(hash);
+        if (!map.field) {
+            return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, "Unknown peer schema");
+        }
+        T::deserializeMappedFields(it, end, target, map);
+        return SerializationResult<void>::Success();
+    }
+
+    // Fill a document with the struct's fields for Format; false if the pool
+    // ran out
+    template<typename Format, typename T>
+    static bool fillDocument(JsonDocument& doc, const T& value) {
+        JsonObject obj = doc.to<JsonObject>();
+        value.serializeInto(obj);
+        if (!StructaWritesText<Format>::value && T::HAS_FIXED_TEXT) value.fixedAsNumbers(obj);
+        return !doc.overflowed();
+    }
+
+    // JSON text as a String sized up front with measureJson()
+    template<typename T>
+    static SerializationResult<String> writeString(JsonDocument& doc, const T& value) {
+        STRUCTA_CHECK_RULES(T, SerializationResult<String>, value.validateSelf())
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::SERIALIZE, doc);
+        if (!fillDocument<StructaJsonFormat>(doc, value)) {
+            return SerializationResult<String>::Failure(
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded");
+        }
+        String result;
+        result.reserve(measureJson(doc));
+        if (serializeJson(doc, result) == 0) {
+            return SerializationResult<String>::Failure(
+                SerializationError::INVALID_JSON, "Failed to serialize");
+        }
+        tracking.output(result.length());
+        return SerializationResult<String>::Success(std::move(result));
+    }
+
+    // Write to a caller buffer; reports overflow instead of truncating
+    template<typename Format>
+    static SerializationResult<size_t> writeOutput(const JsonDocument& doc, char* buffer, size_t size) {
+        size_t written = Format::write(doc, buffer, size);
+        if (written == 0) {
+            if (size > 0) buffer[0] = '\0';
+            return SerializationResult<size_t>::Failure(
+                SerializationError::BUFFER_OVERFLOW, "Output buffer too small");
+        }
+        return SerializationResult<size_t>::Success(written);
+    }
+
+    // Parse failures; a full pool is a capacity problem, not bad input
+    template<typename T>
+    static SerializationResult<T> parseFailure(const DeserializationError& err) {
+        if (err == DeserializationError::NoMemory) {
+            return SerializationResult<T>::Failure(
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded");
+        }
+        return SerializationResult<T>::Failure(
+            SerializationError::INVALID_JSON, String("Parse error: ") + err.c_str());
+    }
+
+    // A filter that lost keys would silently drop declared fields, so reads
+    // through it are refused
+    template<typename R>
+    static SerializationResult<R> filterFailure() {
+        return SerializationResult<R>::Failure(
+            SerializationError::BUFFER_OVERFLOW, "Filter capacity exceeded");
+    }
+
+    // Parse input with Format into a T-sized document and fill target in place
+    template<typename T, typename Format, typename... Input>
+    static SerializationResult<void> readInto(T& target, Input&&... input) {
+        typename T::Document doc;
+        return readWith<T, Format>(doc, target, std::forward<Input>(input)...);
+    }
+
+    // Same as readInto, parsing into a caller-supplied (possibly reused) document.
+    // Keys T does not declare are dropped by T's filter while parsing, and
+    // target is left untouched when the document breaks one of T's rules.
+    template<typename T, typename Format, typename... Input>
+    static SerializationResult<void> readWith(JsonDocument& doc, T& target, Input&&... input) {
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::DESERIALIZE, doc);
+        if (!T::jsonFilterComplete()) return filterFailure<void>();
+        DeserializationError err = Format::read(doc, std::forward<Input>(input)..., T::jsonFilter());
+        if (err) return parseFailure<void>(err);
+        JsonObject obj = doc.template as<JsonObject>();
+        STRUCTA_CHECK_RULES(T, SerializationResult<void>, T::validateSchema(obj))
+        T::deserializeFields(obj, target);
+        return SerializationResult<void>::Success();
+    }
+
+    // Tokenize straight into target; counted as a deserialize with no document.
+    // With no document to inspect, rules are checked on the filled members.
+    template<typename T>
+    static SerializationResult<void> readDirect(StructaReader& reader, T& target) {
+        bool parsed = T::parseFields(reader, target);
+        MemoryTracker::recordOperation(T::memoryStats(), MemoryTracker::DESERIALIZE, 0, 0);
+        if (!parsed) {
+            return SerializationResult<void>::Failure(
+                SerializationError::INVALID_JSON, String("Parse error: ") + reader.error());
+        }
+        STRUCTA_CHECK_RULES(T, SerializationResult<void>, target.validateSelf())
+        return SerializationResult<void>::Success();
+    }
+
+    // Patches merge into target, so only the keys a patch carries are held to
+    // their rules (a key it leaves out is not missing), then the merged
+    // members as a whole. When anything is checked after the merge it is made
+    // on a copy, kept only on success, so a rejected patch changes nothing.
+    template<typename T, typename Format, typename... Input>
+    static SerializationResult<void> patchWith(T& target, bool validateData, Input&&... input) {
+        typename T::Document doc;
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::DESERIALIZE, doc);
+        if (!T::jsonFilterComplete()) return filterFailure<void>();
+        DeserializationError err = Format::read(doc, std::forward<Input>(input)..., T::jsonFilter());
+        if (err) return parseFailure<void>(err);
+        return mergePatch(doc.template as<JsonObject>(), target, validateData);
+    }
+
+    template<typename T>
+    static SerializationResult<void> mergePatch(const JsonObject& obj, T& target, bool validateData) {
+        STRUCTA_CHECK_RULES(T, SerializationResult<void>, T::validatePatch(obj))
+        if (!T::HAS_RULES && !(T::HAS_VALIDATORS && validateData)) {
+            T::deserializeFields(obj, target);
+            return SerializationResult<void>::Success();
+        }
+        T patched(target);
+        T::deserializeFields(obj, patched);
+        STRUCTA_CHECK_RULES(T, SerializationResult<void>, patched.validateSelf())
+        SerializationResult<void> result = checkValidation(patched, SerializationResult<void>::Success(), validateData);
+        if (result.success) target = std::move(patched);
+        return result;
+    }
+
+    // Direct reads write members as they are tokenized, so when T has rules or
+    // validators to pass they go into a copy of target that is only kept on
+    // success, leaving target as it was on a rejected payload like readWith.
+    // With nothing to check, a syntax error may leave earlier members written.
+    template<typename T>
+    static SerializationResult<void> readDirectInto(StructaReader& reader, T& target, bool validateData) {
+        if (!T::HAS_RULES && !(T::HAS_VALIDATORS && validateData)) {
+            return readDirect(reader, target);
+        }
+        T scratch(target);
+        SerializationResult<void> result = checkValidation(scratch, readDirect(reader, scratch), validateData);
+        if (result.success) target = std::move(scratch);
+        return result;
+    }
+
+    // After a successful read, runs T's validator list when validateData asks
+    // for it; types without one (HAS_VALIDATORS false) pass parsed through
+    template<typename T>
+    static SerializationResult<void> checkValidation(const T& target, const SerializationResult<void>& parsed, bool validateData) {
+        if (!T::HAS_VALIDATORS || !parsed.success || !validateData) return parsed;
+        auto validationResult = target.validate();
+        if (!validationResult.success) {
+            return SerializationResult<void>::Failure(
+                validationResult.error.code,
+                validationResult.error.message,
+                validationResult.error.fieldPath);
+        }
+        return parsed;
+    }
+
+    // Fill doc from value and write it with Format to a buffer or Print
+    template<typename Format, typename T, typename... Output>
+    static SerializationResult<size_t> writeWith(JsonDocument& doc, const T& value, Output&&... output) {
+        STRUCTA_CHECK_RULES(T, SerializationResult<size_t>, value.validateSelf())
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::SERIALIZE, doc);
+        if (!fillDocument<Format>(doc, value)) {
+            return SerializationResult<size_t>::Failure(
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded");
+        }
+        auto result = writeOutput<Format>(doc, std::forward<Output>(output)...);
+        if (result.success) tracking.output(result.data);
+        return result;
+    }
+
+    // JSON text into the context's output String, whose buffer is kept between calls
+    template<typename T>
+    static SerializationResult<size_t> writeWith(StructaContext& ctx, const T& value) {
+        STRUCTA_CHECK_RULES(T, SerializationResult<size_t>, value.validateSelf())
+        JsonDocument& doc = ctx.document();
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::SERIALIZE, doc);
+        if (!fillDocument<StructaJsonFormat>(doc, value)) {
+            return SerializationResult<size_t>::Failure(
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded");
+        }
+        String& text = ctx.output();
+        text = "";
+        text.reserve(measureJson(doc));
+        size_t written = serializeJson(doc, text);
+        if (written == 0) {
+            return SerializationResult<size_t>::Failure(
+                SerializationError::INVALID_JSON, "Failed to serialize");
+        }
+        tracking.output(written);
+        return SerializationResult<size_t>::Success(written);
+    }
+
+    // Stream to any Print (Serial, WiFiClient, File...)
+    template<typename Format>
+    static SerializationResult<size_t> writeOutput(const JsonDocument& doc, Print& out) {
+        size_t written = Format::write(doc, out);
+        if (written == 0) {
+            return SerializationResult<size_t>::Failure(
+                SerializationError::INVALID_JSON, "Failed to write output");
+        }
+        return SerializationResult<size_t>::Success(written);
+    }
+
+    // Batches: an array of records written or read through one reused
+    // document. items is anything indexable with items[i] yielding a const T&,
+    // such as a plain array or a record buffer unpacking into a scratch struct.
+    template<typename Format, typename T, typename Items>
+    static SerializationResult<size_t> writeBatch(Items& items, size_t count, Print& out) {
+        typename T::Document doc;
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::BATCH, doc);
+        size_t written = Format::beginBatch(out, count);
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) written += Format::nextItem(out);
+            const T& item = items[i];
+            STRUCTA_CHECK_RULES(T, SerializationResult<size_t>, item.validateSelf())
+            if (!fillDocument<Format>(doc, item)) {
+                return SerializationResult<size_t>::Failure(
+                    SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded", "[" + String(i) + "]");
+            }
+            written += Format::write(doc, out);
+            tracking.sample();
+        }
+        written += Format::endBatch(out);
+        tracking.output(written);
+        return SerializationResult<size_t>::Success(written);
+    }
+
+    template<typename T>
+    static SerializationResult<size_t> readBatch(Stream& input, T* items, size_t maxItems) {
+        if (peekToken(input) != '[') {
+            return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Expected array");
+        }
+        input.read();
+        if (peekToken(input) == ']') {
+            input.read();
+            return SerializationResult<size_t>::Success(0);
+        }
+        if (!T::jsonFilterComplete()) return filterFailure<size_t>();
+        typename T::Document doc;
+        MemoryTracker::Scope tracking(T::memoryStats(), MemoryTracker::BATCH, doc);
+        size_t count = 0;
+        while (true) {
+            if (count == maxItems) {
+                return SerializationResult<size_t>::Failure(
+                    SerializationError::BUFFER_OVERFLOW, "Too many items", "[" + String(count) + "]");
+            }
+            DeserializationError err = deserializeJson(doc, input, DeserializationOption::Filter(T::jsonFilter()));
+            if (err) {
+                return parseFailure<size_t>(err);
+            }
+            tracking.sample();
+            JsonObject obj = doc.template as<JsonObject>();
+            STRUCTA_CHECK_RULES(T, SerializationResult<size_t>, T::validateSchema(obj))
+            T::deserializeFields(obj, items[count++]);
+            int next = peekToken(input);
+            input.read();
+            if (next == ']') break;
+            if (next != ',') {
+                return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Expected ',' or ']'");
+            }
+        }
+        return SerializationResult<size_t>::Success(count);
+    }
+
+    // Next non-whitespace character in the stream, left unread
+    static int peekToken(Stream& input) {
+        int c = input.peek();
+        while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            input.read();
+            c = input.peek();
+        }
+        return c;
+    }
+
+    // ---- Descriptor tables ----
+    // Kind of a member type; 64-bit integers go through KIND_CUSTOM so
+    // boards without long long support in ArduinoJson never see them
+    template<typename T>
+    static constexpr uint8_t kindOf() {
+        return std::is_same<T, bool>::value ? (uint8_t)StructaField::KIND_BOOL
+             : std::is_integral<T>::value && sizeof(T) <= 4 ? integralKind(sizeof(T), std::is_signed<T>::value)
+             : std::is_same<T, float>::value ? (uint8_t)StructaField::KIND_FLOAT
+             : std::is_same<T, double>::value ? (uint8_t)StructaField::KIND_DOUBLE
+             : std::is_same<T, String>::value ? (uint8_t)StructaField::KIND_STRING
+             : std::is_same<T, const char*>::value ? (uint8_t)StructaField::KIND_CSTR
+             : HasSerialize<T>::value ? (uint8_t)StructaField::KIND_OBJECT
+             : (uint8_t)StructaField::KIND_CUSTOM;
+    }
+
+    static constexpr uint8_t integralKind(size_t size, bool isSigned) {
+        return size == 1 ? (isSigned ? StructaField::KIND_INT8 : StructaField::KIND_UINT8)
+             : size == 2 ? (isSigned ? StructaField::KIND_INT16 : StructaField::KIND_UINT16)
+             : (isSigned ? StructaField::KIND_INT32 : StructaField::KIND_UINT32);
+    }
+
+    template<typename T, bool IsObject = HasSerialize<T>::value>
+    struct NestedTable {
+        static constexpr const StructaDescriptor& (*get())() { return nullptr; }
+    };
+
+    template<typename T>
+    struct NestedTable<T, true> {
+        static constexpr const StructaDescriptor& (*get())() { return &T::descriptor; }
+    };
+
+    template<typename T>
+    struct CustomOps {
+        static void write(JsonObject& obj, StructaKeyText key, const void* value) {
+            serializeField(obj, key, *static_cast<const T*>(value));
+        }
+        static void read(JsonVariant v, void* value) { readField(v, *static_cast<T*>(value)); }
+        static bool same(const void* a, const void* b) {
+            return sameValue(*static_cast<const T*>(a), *static_cast<const T*>(b));
+        }
+        static void filter(JsonObject& filter, StructaKeyText key) {
+            filterField(filter, key, static_cast<const T*>(nullptr));
+        }
+        static const StructaFieldOps ops;
+    };
+
+    // Encoded floats: the table points at the member, the helpers take a view
+    template<typename T, int32_t Scale, uint8_t Decimals>
+    struct CustomOps<StructaScaled<T, Scale, Decimals> > {
+        static void write(JsonObject& obj, StructaKeyText key, const void* value) {
+            serializeField(obj, key, StructaScaled<const T, Scale, Decimals>(*static_cast<const T*>(value)));
+        }
+        static void read(JsonVariant v, void* value) {
+            readField(v, StructaScaled<T, Scale, Decimals>(*static_cast<T*>(value)));
+        }
+        static bool same(const void* a, const void* b) {
+            return *static_cast<const T*>(a) == *static_cast<const T*>(b);
+        }
+        static void filter(JsonObject& filter, StructaKeyText key) { filter[key] = true; }
+        static const StructaFieldOps ops;
+    };
+
+    template<typename T, bool IsCustom>
+    struct OpsTable {
+        static constexpr const StructaFieldOps* get() { return nullptr; }
+    };
+
+    template<typename T>
+    struct OpsTable<T, true> {
+        static constexpr const StructaFieldOps* get() { return &CustomOps<T>::ops; }
+    };
+
+    // Table entry for one member; generated descriptor() calls describe()
+    template<typename T>
+    struct FieldTraits {
+        static constexpr bool custom = kindOf<T>() == StructaField::KIND_CUSTOM;
+        static constexpr StructaField describe(uint16_t nameAt, uint32_t hash, size_t offset) {
+            return StructaField{nameAt, (uint16_t)offset, hash, kindOf<T>(), 0, 0, 0, 0,
+                                NestedTable<T>::get(), OpsTable<T, custom>::get()};
+        }
+    };
+
+    template<typename T, size_t N>
+    struct FieldTraits<T[N]> {
+        static constexpr bool custom = kindOf<T>() == StructaField::KIND_CUSTOM;
+        static constexpr StructaField describe(uint16_t nameAt, uint32_t hash, size_t offset) {
+            return StructaField{nameAt, (uint16_t)offset, hash,
+                                custom ? (uint8_t)StructaField::KIND_CUSTOM : (uint8_t)StructaField::KIND_ARRAY,
+                                kindOf<T>(), (uint16_t)N, (uint16_t)sizeof(T), 0,
+                                NestedTable<T>::get(), OpsTable<T[N], custom>::get()};
+        }
+    };
+
+    template<typename T, size_t N>
+    struct FieldTraits<StructaArray<T, N> > {
+        typedef StructaArray<T, N> List;
+        static constexpr bool custom = kindOf<T>() == StructaField::KIND_CUSTOM;
+        static constexpr StructaField describe(uint16_t nameAt, uint32_t hash, size_t offset) {
+            STRUCTA_OFFSETS_BEGIN
+            return StructaField{nameAt, (uint16_t)offset, hash,
+                                custom ? (uint8_t)StructaField::KIND_CUSTOM : (uint8_t)StructaField::KIND_LIST,
+                                kindOf<T>(), (uint16_t)N, (uint16_t)sizeof(T),
+                                (uint16_t)offsetof(List, count),
+                                NestedTable<T>::get(), OpsTable<List, custom>::get()};
+            STRUCTA_OFFSETS_END
+        }
+    };
+
+    // ---- Descriptor engine ----
+    // Shared by every struct built with STRUCTA_INLINE_FIELDS 0. The sinks
+    // let one scalar switch write both object members and array items.
+    struct MemberSink {
+        JsonObject& obj;
+        StructaKeyText key;
+        template<typename V> void set(const V& value) { obj[key] = value; }
+    };
+
+    struct ItemSink {
+        JsonArray& arr;
+        template<typename V> void set(const V& value) { arr.add(value); }
+    };
+
+    template<typename Sink>
+    static void tableWriteScalar(Sink& sink, uint8_t kind, const void* p) {
+        switch (kind) {
+            case StructaField::KIND_BOOL: sink.set(*static_cast<const bool*>(p)); break;
+            case StructaField::KIND_INT8: sink.set(*static_cast<const int8_t*>(p)); break;
+            case StructaField::KIND_UINT8: sink.set(*static_cast<const uint8_t*>(p)); break;
+            case StructaField::KIND_INT16: sink.set(*static_cast<const int16_t*>(p)); break;
+            case StructaField::KIND_UINT16: sink.set(*static_cast<const uint16_t*>(p)); break;
+            case StructaField::KIND_INT32: sink.set(*static_cast<const int32_t*>(p)); break;
+            case StructaField::KIND_UINT32: sink.set(*static_cast<const uint32_t*>(p)); break;
+            case StructaField::KIND_FLOAT: sink.set(*static_cast<const float*>(p)); break;
+            case StructaField::KIND_DOUBLE: sink.set(*static_cast<const double*>(p)); break;
+            case StructaField::KIND_STRING: sink.set(*static_cast<const String*>(p)); break;
+            case StructaField::KIND_CSTR: sink.set(*static_cast<const char* const*>(p)); break;
+            default: break;
+        }
+    }
+
+    static void tableReadScalar(JsonVariant v, uint8_t kind, void* p) {
+        if (kind == StructaField::KIND_STRING) {
+            readField(v, *static_cast<String*>(p));
+            return;
+        }
+        if (v.isNull()) return;
+        switch (kind) {
+            case StructaField::KIND_BOOL: *static_cast<bool*>(p) = v.as<bool>(); break;
+            case StructaField::KIND_INT8: *static_cast<int8_t*>(p) = v.as<int8_t>(); break;
+            case StructaField::KIND_UINT8: *static_cast<uint8_t*>(p) = v.as<uint8_t>(); break;
+            case StructaField::KIND_INT16: *static_cast<int16_t*>(p) = v.as<int16_t>(); break;
+            case StructaField::KIND_UINT16: *static_cast<uint16_t*>(p) = v.as<uint16_t>(); break;
+            case StructaField::KIND_INT32: *static_cast<int32_t*>(p) = v.as<int32_t>(); break;
+            case StructaField::KIND_UINT32: *static_cast<uint32_t*>(p) = v.as<uint32_t>(); break;
+            case StructaField::KIND_FLOAT: *static_cast<float*>(p) = v.as<float>(); break;
+            case StructaField::KIND_DOUBLE: *static_cast<double*>(p) = v.as<double>(); break;
+            case StructaField::KIND_CSTR: *static_cast<const char**>(p) = v.as<const char*>(); break;
+            default: break;
+        }
+    }
+
+    static bool tableSameScalar(uint8_t kind, const void* a, const void* b) {
+        switch (kind) {
+            case StructaField::KIND_BOOL: return *static_cast<const bool*>(a) == *static_cast<const bool*>(b);
+            case StructaField::KIND_INT8:
+            case StructaField::KIND_UINT8: return *static_cast<const uint8_t*>(a) == *static_cast<const uint8_t*>(b);
+            case StructaField::KIND_INT16:
+            case StructaField::KIND_UINT16: return *static_cast<const uint16_t*>(a) == *static_cast<const uint16_t*>(b);
+            case StructaField::KIND_INT32:
+            case StructaField::KIND_UINT32: return *static_cast<const uint32_t*>(a) == *static_cast<const uint32_t*>(b);
+            case StructaField::KIND_FLOAT: return *static_cast<const float*>(a) == *static_cast<const float*>(b);
+            case StructaField::KIND_DOUBLE: return *static_cast<const double*>(a) == *static_cast<const double*>(b);
+            case StructaField::KIND_STRING: return *static_cast<const String*>(a) == *static_cast<const String*>(b);
+            case StructaField::KIND_CSTR: return *static_cast<const char* const*>(a) == *static_cast<const char* const*>(b);
+            default: return true;
+        }
+    }
+
+    // Elements a fixed array or list holds right now
+    static size_t tableItemCount(const StructaField& f, const void* p) {
+        if (f.kind != StructaField::KIND_LIST) return f.capacity;
+        size_t count = *reinterpret_cast<const size_t*>(static_cast<const char*>(p) + f.countOffset);
+        return count < f.capacity ? count : f.capacity;
+    }
+
+    static void tableWriteItems(JsonArray& arr, const StructaField& f, const void* p) {
+        const char* item = static_cast<const char*>(p);
+        size_t count = tableItemCount(f, p);
+        for (size_t i = 0; i < count; ++i, item += f.stride) {
+            if (f.element == StructaField::KIND_OBJECT) {
+                JsonObject child = arr.createNestedObject();
+                tableWrite(f.nested(), child, item);
+            } else {
+                ItemSink sink = {arr};
+                tableWriteScalar(sink, f.element, item);
+            }
+        }
+    }
+
+    static void tableWriteValue(JsonObject& obj, StructaKeyText key, const StructaField& f, const void* p) {
+        switch (f.kind) {
+            case StructaField::KIND_OBJECT: {
+                JsonObject child = obj.createNestedObject(key);
+                tableWrite(f.nested(), child, p);
+                break;
+            }
+            case StructaField::KIND_ARRAY:
+            case StructaField::KIND_LIST: {
+                JsonArray arr = obj.createNestedArray(key);
+                tableWriteItems(arr, f, p);
+                break;
+            }
+            case StructaField::KIND_CUSTOM:
+                f.ops->write(obj, key, p);
+                break;
+            default: {
+                MemberSink sink = {obj, key};
+                tableWriteScalar(sink, f.kind, p);
+                break;
+            }
+        }
+    }
+
+    static void tableReadValue(JsonVariant v, const StructaField& f, void* p) {
+        switch (f.kind) {
+            case StructaField::KIND_OBJECT:
+                if (v.is<JsonObject>()) tableRead(f.nested(), v.as<JsonObject>(), p);
+                break;
+            case StructaField::KIND_ARRAY:
+            case StructaField::KIND_LIST: {
+                JsonArray arr = v.as<JsonArray>();
+                if (arr.isNull()) break;
+                char* item = static_cast<char*>(p);
+                size_t count = 0;
+                for (JsonArray::iterator it = arr.begin(); it != arr.end() && count < f.capacity; ++it, ++count) {
+                    if (f.element == StructaField::KIND_OBJECT) {
+                        if ((*it).is<JsonObject>()) tableRead(f.nested(), (*it).as<JsonObject>(), item);
+                    } else {
+                        tableReadScalar(*it, f.element, item);
+                    }
+                    item += f.stride;
+                }
+                if (f.kind == StructaField::KIND_LIST) {
+                    *reinterpret_cast<size_t*>(static_cast<char*>(p) + f.countOffset) = count;
+                }
+                break;
+            }
+            case StructaField::KIND_CUSTOM:
+                f.ops->read(v, p);
+                break;
+            default:
+                tableReadScalar(v, f.kind, p);
+                break;
+        }
+    }
+
+    static bool tableSameValue(const StructaField& f, const void* a, const void* b) {
+        switch (f.kind) {
+            case StructaField::KIND_OBJECT:
+                return tableSame(f.nested(), a, b);
+            case StructaField::KIND_ARRAY:
+            case StructaField::KIND_LIST: {
+                size_t count = tableItemCount(f, a);
+                if (count != tableItemCount(f, b)) return false;
+                const char* x = static_cast<const char*>(a);
+                const char* y = static_cast<const char*>(b);
+                for (size_t i = 0; i < count; ++i, x += f.stride, y += f.stride) {
+                    bool same = f.element == StructaField::KIND_OBJECT ? tableSame(f.nested(), x, y)
+                                                                       : tableSameScalar(f.element, x, y);
+                    if (!same) return false;
+                }
+                return true;
+            }
+            case StructaField::KIND_CUSTOM:
+                return f.ops->same(a, b);
+            default:
+                return tableSameScalar(f.kind, a, b);
+        }
+    }
+
+    static void tableWrite(const StructaDescriptor& d, JsonObject& obj, const void* value) {
+        for (uint8_t i = 0; i < d.count; ++i) {
+            StructaField f = d.field(i);
+            tableWriteValue(obj, d.key(f), f, static_cast<const char*>(value) + f.offset);
+        }
+    }
+
+    // One pass over the object; keys are matched by hash, then by name
+    static void tableRead(const StructaDescriptor& d, const JsonObject& o, void* value) {
+        for (JsonPair kv : o) {
+            const char* key = kv.key().c_str();
+            uint32_t h = StructaKey::hashRuntime(key);
+            for (uint8_t i = 0; i < d.count; ++i) {
+                if (d.hash(i) != h) continue;
+                StructaField f = d.field(i);
+                if (STRUCTA_NAME_EQUALS(key, d.names + f.nameAt)) {
+                    tableReadValue(kv.value(), f, static_cast<char*>(value) + f.offset);
+                    break;
+                }
+            }
+        }
+    }
+
+    static bool tableSame(const StructaDescriptor& d, const void* a, const void* b) {
+        for (uint8_t i = 0; i < d.count; ++i) {
+            StructaField f = d.field(i);
+            if (!tableSameValue(f, static_cast<const char*>(a) + f.offset, static_cast<const char*>(b) + f.offset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static uint64_t tableChanged(const StructaDescriptor& d, const void* value, const void* since) {
+        uint64_t mask = 0;
+        for (uint8_t i = 0; i < d.count; ++i) {
+            StructaField f = d.field(i);
+            if (!tableSameValue(f, static_cast<const char*>(value) + f.offset, static_cast<const char*>(since) + f.offset)) {
+                mask |= (uint64_t)1 << i;
+            }
+        }
+        return mask;
+    }
+
+    static void tableWriteDelta(const StructaDescriptor& d, JsonObject& obj, const void* value, const void* since) {
+        for (uint8_t i = 0; i < d.count; ++i) {
+            StructaField f = d.field(i);
+            const char* current = static_cast<const char*>(value) + f.offset;
+            const char* previous = static_cast<const char*>(since) + f.offset;
+            if (tableSameValue(f, current, previous)) continue;
+            if (f.kind == StructaField::KIND_OBJECT) {
+                JsonObject child = obj.createNestedObject(d.key(f));
+                tableWriteDelta(f.nested(), child, current, previous);
+            } else {
+                tableWriteValue(obj, d.key(f), f, current);
+            }
+        }
+    }
+
+    static void tableFilter(const StructaDescriptor& d, JsonObject& filter) {
+        for (uint8_t i = 0; i < d.count; ++i) {
+            StructaField f = d.field(i);
+            StructaKeyText key = d.key(f);
+            if (f.kind == StructaField::KIND_OBJECT) {
+                JsonObject child = filter.createNestedObject(key);
+                tableFilter(f.nested(), child);
+            } else if ((f.kind == StructaField::KIND_ARRAY || f.kind == StructaField::KIND_LIST) &&
+                       f.element == StructaField::KIND_OBJECT) {
+                JsonObject child = filter.createNestedArray(key).createNestedObject();
+                tableFilter(f.nested(), child);
+            } else if (f.kind == StructaField::KIND_CUSTOM) {
+                f.ops->filter(filter, key);
+            } else {
+                filter[key] = true;
+            }
+        }
+    }
+};
+
+template<typename T>
+const StructaFieldOps JsonStruct::CustomOps<T>::ops = {
+    &JsonStruct::CustomOps<T>::write, &JsonStruct::CustomOps<T>::read,
+    &JsonStruct::CustomOps<T>::same, &JsonStruct::CustomOps<T>::filter
+};
+
+template<typename T, int32_t Scale, uint8_t Decimals>
+const StructaFieldOps JsonStruct::CustomOps<StructaScaled<T, Scale, Decimals> >::ops = {
+    &JsonStruct::CustomOps<StructaScaled<T, Scale, Decimals> >::write,
+    &JsonStruct::CustomOps<StructaScaled<T, Scale, Decimals> >::read,
+    &JsonStruct::CustomOps<StructaScaled<T, Scale, Decimals> >::same,
+    &JsonStruct::CustomOps<StructaScaled<T, Scale, Decimals> >::filter
+};
+
+// ======================================================
+// Field Visitors
+// ======================================================
+// forEachField(visitor) calls visitor(name, member) for each field in
+// FIELD_LIST order with the member's declared type, so overloads pick the
+// handling at compile time. forEachFieldType(visitor) needs no instance and
+// passes a null const T* that only carries the type. The printers below are
+// built on them and write straight to a Print, without documents or Strings.
+struct StructaTypeName {
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type
+    print(Print& out, const T*) {
+        out.print(std::is_signed<T>::value ? STRUCTA_TEXT("int") : STRUCTA_TEXT("uint"));
+        out.print((unsigned)(sizeof(T) * 8));
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    print(Print& out, const T*) {
+        out.print(sizeof(T) == sizeof(float) ? STRUCTA_TEXT("float") : STRUCTA_TEXT("double"));
+    }
+
+    template<typename T>
+    static typename std::enable_if<HasSerialize<T>::value>::type
+    print(Print& out, const T*) { out.print(STRUCTA_TEXT("object")); }
+
+    static void print(Print& out, const bool*) { out.print(STRUCTA_TEXT("bool")); }
+    static void print(Print& out, const String*) { out.print(STRUCTA_TEXT("String")); }
+    static void print(Print& out, const char* const*) { out.print(STRUCTA_TEXT("const char*")); }
+
+    template<typename E>
+    static void print(Print& out, const StructaEnum<E>*) { out.print(STRUCTA_TEXT("enum")); }
+
+    template<size_t N>
+    static void print(Print& out, const StructaFixedString<N>*) {
+        out.print(STRUCTA_TEXT("char[<="));
+        out.print((unsigned)N);
+        out.print(']');
+    }
+
+    template<typename T, size_t N>
+    static void print(Print& out, const T (*)[N]) {
+        print(out, static_cast<const T*>(nullptr));
+        out.print('[');
+        out.print((unsigned)N);
+        out.print(']');
+    }
+
+    template<typename T, size_t N>
+    static void print(Print& out, const StructaArray<T, N>*) {
+        print(out, static_cast<const T*>(nullptr));
+        out.print(STRUCTA_TEXT("[<="));
+        out.print((unsigned)N);
+        out.print(']');
+    }
+};
+
+// Lists each field as "name (type)"
+class StructaFieldInfoPrinter {
+public:
+    explicit StructaFieldInfoPrinter(Print& out) : out_(out) {}
+
+    template<typename T>
+    void operator()(StructaKeyText name, const T* type) {
+        out_.print(STRUCTA_TEXT("  - "));
+        out_.print(name);
+        out_.print(STRUCTA_TEXT(" ("));
+        StructaTypeName::print(out_, type);
+        out_.println(')');
+    }
+
+private:
+    Print& out_;
+};
+
+// Prints "name: value" lines; nested structs and arrays of them are indented below
+class StructaFieldPrinter {
+public:
+    explicit StructaFieldPrinter(Print& out, uint8_t indent = 2) : out_(out), indent_(indent) {}
+
+    template<typename T>
+    typename std::enable_if<!HasSerialize<T>::value>::type
+    operator()(StructaKeyText name, const T& value) {
+        begin(name);
+        printScalar(value);
+        out_.println();
+    }
+
+    template<typename T>
+    typename std::enable_if<HasSerialize<T>::value>::type
+    operator()(StructaKeyText name, const T& value) {
+        pad(indent_);
+        out_.print(name);
+        out_.println(':');
+        StructaFieldPrinter nested(out_, indent_ + 2);
+        value.forEachField(nested);
+    }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText name, const T (&value)[N]) { printItems(name, value, N); }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText name, const StructaArray<T, N>& value) {
+        printItems(name, value.items, value.count < N ? value.count : N);
+    }
+
+private:
+    void pad(uint8_t width) const {
+        for (uint8_t i = 0; i < width; i++) out_.print(' ');
+    }
+
+    void begin(StructaKeyText name) {
+        pad(indent_);
+        out_.print(name);
+        out_.print(STRUCTA_TEXT(": "));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    printScalar(T value) { out_.print((long)value); }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    printScalar(T value) { out_.print((unsigned long)value); }
+
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    printScalar(T value) { out_.print((double)value, 2); }
+
+    void printScalar(bool value) { out_.print(value ? STRUCTA_TEXT("true") : STRUCTA_TEXT("false")); }
+
+    void printScalar(const char* value) {
+        if (!value) {
+            out_.print(STRUCTA_TEXT("null"));
+            return;
+        }
+        out_.print('"');
+        out_.print(value);
+        out_.print('"');
+    }
+
+    void printScalar(const String& value) { printScalar(value.c_str()); }
+
+    template<size_t N>
+    void printScalar(const StructaFixedString<N>& value) { printScalar(value.c_str()); }
+
+    template<typename E>
+    void printScalar(const StructaEnum<E>& value) {
+        if (value.valid()) out_.print(STRUCTA_FLASH(value.name()));
+        else out_.print((unsigned)value.value);
+    }
+
+    template<typename T, size_t N>
+    void printScalar(const T (&values)[N]) {
+        out_.print('[');
+        for (size_t i = 0; i < N; i++) {
+            if (i) out_.print(STRUCTA_TEXT(", "));
+            printScalar(values[i]);
+        }
+        out_.print(']');
+    }
+
+    template<typename T>
+    typename std::enable_if<!HasSerialize<T>::value>::type
+    printItems(StructaKeyText name, const T* items, size_t count) {
+        begin(name);
+        out_.print('[');
+        for (size_t i = 0; i < count; i++) {
+            if (i) out_.print(STRUCTA_TEXT(", "));
+            printScalar(items[i]);
+        }
+        out_.println(']');
+    }
+
+    template<typename T>
+    typename std::enable_if<HasSerialize<T>::value>::type
+    printItems(StructaKeyText name, const T* items, size_t count) {
+        begin(name);
+        out_.print(STRUCTA_TEXT("[Array of "));
+        out_.print((unsigned long)count);
+        out_.println(']');
+        for (size_t i = 0; i < count; i++) {
+            pad(indent_ + 2);
+            out_.print('[');
+            out_.print((unsigned long)i);
+            out_.println(']');
+            StructaFieldPrinter nested(out_, indent_ + 4);
+            items[i].forEachField(nested);
+        }
+    }
+
+    Print& out_;
+    uint8_t indent_;
+};
+
+// ======================================================
+// Record Buffers
+// ======================================================
+// A packed record is a struct's fields laid end to end in FIELD_LIST order,
+// in the host's byte order and with no padding: numbers and bools at their
+// own size, enums as one byte, StructaFixedString<N> as N + 1 bytes,
+// StructaArray as a uint16_t count and all N slots. Every record of a type
+// has the same size, structName::packedSize. String and const char* fields
+// have no fixed size; packing a struct with one fails to compile.
+template<typename T, bool nested = HasSerialize<T>::value>
+struct StructaPackedSize {
+    static constexpr size_t value = std::is_arithmetic<T>::value ? sizeof(T) : 0;
+};
+template<typename T> struct StructaPackedSize<T, true> {
+    static constexpr size_t value = T::packedSize;
+};
+template<typename T, size_t N> struct StructaPackedSize<T[N], false> {
+    static constexpr size_t value = N * StructaPackedSize<T>::value;
+};
+template<typename T, size_t N> struct StructaPackedSize<StructaArray<T, N>, false> {
+    static constexpr size_t value = sizeof(uint16_t) + N * StructaPackedSize<T>::value;
+};
+template<typename E> struct StructaPackedSize<StructaEnum<E>, false> {
+    static constexpr size_t value = 1;
+};
+template<size_t N> struct StructaPackedSize<StructaFixedString<N>, false> {
+    static constexpr size_t value = N + 1;
+};
+
+// forEachField visitors that write a record to, or read one from, the
+// bytes at a cursor
+class StructaPackWriter {
+public:
+    explicit StructaPackWriter(uint8_t* out) : out_(out) {}
+    uint8_t* position() const { return out_; }
+
+    template<typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    operator()(StructaKeyText, const T& value) { put(&value, sizeof(T)); }
+
+    template<typename T>
+    typename std::enable_if<HasSerialize<T>::value>::type
+    operator()(StructaKeyText, const T& value) { value.forEachField(*this); }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText key, const T (&values)[N]) {
+        for (size_t i = 0; i < N; ++i) (*this)(key, values[i]);
+    }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText key, const StructaArray<T, N>& values) {
+        uint16_t count = (uint16_t)(values.count < N ? values.count : N);
+        put(&count, sizeof(count));
+        (*this)(key, values.items);
+    }
+
+    template<typename E>
+    void operator()(StructaKeyText, const StructaEnum<E>& value) { *out_++ = value.value; }
+
+    // Zero-filled past the text, so equal records are equal bytes
+    template<size_t N>
+    void operator()(StructaKeyText, const StructaFixedString<N>& value) {
+        strncpy(reinterpret_cast<char*>(out_), value.text, N + 1);
+        out_ += N + 1;
+    }
+
+    template<typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value && !HasSerialize<T>::value>::type
+    operator()(StructaKeyText, const T&) {
+        static_assert(sizeof(T) == 0, "Packed records need fixed-size fields; use StructaFixedString<N> for text");
+    }
+
+private:
+    void put(const void* value, size_t size) {
+        memcpy(out_, value, size);
+        out_ += size;
+    }
+
+    uint8_t* out_;
+};
+
+class StructaPackReader {
+public:
+    explicit StructaPackReader(const uint8_t* in) : in_(in) {}
+    const uint8_t* position() const { return in_; }
+
+    template<typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    operator()(StructaKeyText, T& value) { take(&value, sizeof(T)); }
+
+    template<typename T>
+    typename std::enable_if<HasSerialize<T>::value>::type
+    operator()(StructaKeyText, T& value) { value.forEachField(*this); }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText key, T (&values)[N]) {
+        for (size_t i = 0; i < N; ++i) (*this)(key, values[i]);
+    }
+
+    template<typename T, size_t N>
+    void operator()(StructaKeyText key, StructaArray<T, N>& values) {
+        uint16_t count;
+        take(&count, sizeof(count));
+        values.count = count < N ? count : N;
+        (*this)(key, values.items);
+    }
+
+    template<typename E>
+    void operator()(StructaKeyText, StructaEnum<E>& value) { value.value = *in_++; }
+
+    template<size_t N>
+    void operator()(StructaKeyText, StructaFixedString<N>& value) {
+        take(value.text, N + 1);
+        value.text[N] = '\0';
+    }
+
+    template<typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value && !HasSerialize<T>::value>::type
+    operator()(StructaKeyText, T&) {
+        static_assert(sizeof(T) == 0, "Packed records need fixed-size fields; use StructaFixedString<N> for text");
+    }
+
+private:
+    void take(void* value, size_t size) {
+        memcpy(value, in_, size);
+        in_ += size;
+    }
+
+    const uint8_t* in_;
+};
+
+// Writes value as a packed record of T::packedSize bytes at out
+template<typename T>
+void structaPack(const T& value, uint8_t* out) {
+    value.forEachField(StructaPackWriter(out));
+}
+
+// Fills value from the packed record at in
+template<typename T>
+void structaUnpack(const uint8_t* in, T& value) {
+    value.forEachField(StructaPackReader(in));
+}
+
+// Holds up to N records of T, packed, in one contiguous block. When full, a
+// push overwrites the oldest record and is counted in dropped(). Records
+// drain oldest first through T's batch serializer, and the whole buffer can
+// be saved to and restored from flash as a snapshot: a small header, then
+// the records oldest first as they are stored, so a restore is a copy and
+// replay unpacks each field instead of parsing text. Snapshots are in the
+// host's byte order, for the device that wrote them. The buffer is not
+// locked; guard it when more than one task uses it.
+//   StructaRingBuffer<Reading, 64> pending;
+//   pending.push(reading);
+//   File f = LittleFS.open("/pending.bin", "w");
+//   pending.saveTo(f);
+//   ...
+//   pending.loadFrom(f);
+//   pending.drainTo(client);               // [{...},{...}] of up to 64
+#ifndef STRUCTA_SNAPSHOT_MAGIC
+#define STRUCTA_SNAPSHOT_MAGIC 0x53524232UL   // "SRB2"
+#endif
+
+struct StructaSnapshotHeader {
+    uint32_t magic;
+    uint16_t schemaVersion;     // STRUCTA_SCHEMA_VERSION of the writer
+    uint16_t recordSize;        // packedSize of the writer's records
+    uint32_t schemaHash;        // T::schemaHash: names, order and kinds of the fields
+    uint32_t count;
+};
+
+template<typename T, size_t N>
+class StructaRingBuffer {
+public:
+    static constexpr size_t RECORD_SIZE = T::packedSize;
+    static_assert(N > 0, "StructaRingBuffer needs room for at least one record");
+    static_assert(RECORD_SIZE <= 0xFFFF, "Packed records are limited to 64 KB");
+
+    StructaRingBuffer() : head_(0), count_(0), dropped_(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == N; }
+    uint32_t dropped() const { return dropped_; }
+    void clear() { head_ = count_ = 0; }
+
+    void push(const T& value) {
+        if (count_ == N) {
+            head_ = (head_ + 1) % N;
+            --count_;
+            ++dropped_;
+        }
+        structaPack(value, slot(count_));
+        ++count_;
+    }
+
+    // Reads the i-th oldest record; false if there are not that many
+    bool peek(size_t i, T& value) const {
+        if (i >= count_) return false;
+        structaUnpack(slot(i), value);
+        return true;
+    }
+
+    bool pop(T& value) {
+        if (!peek(0, value)) return false;
+        discard(1);
+        return true;
+    }
+
+    // Drops the n oldest records
+    void discard(size_t n) {
+        if (n > count_) n = count_;
+        head_ = (head_ + n) % N;
+        count_ -= n;
+    }
+
+    // The packed records oldest first, as at most two runs of bytes
+    const uint8_t* data() const { return storage_; }
+    size_t firstRun() const { return head_ + count_ <= N ? count_ : N - head_; }
+
+    // Writes up to maxItems of the oldest records as one batch in Format and
+    // removes them once the whole batch is out; data holds the bytes written.
+    // On failure every record stays in the buffer.
+    template<typename Format = StructaJsonFormat>
+    SerializationResult<size_t> drainTo(Print& out, size_t maxItems = N) {
+        size_t count = maxItems < count_ ? maxItems : count_;
+        Records records(*this);
+        SerializationResult<size_t> result = T::template serializeBatch<Format>(records, count, out);
+        if (result.success) discard(count);
+        return result;
+    }
+
+    size_t snapshotSize() const { return sizeof(StructaSnapshotHeader) + count_ * RECORD_SIZE; }
+
+    // Header and records to a file or any other Print; returns the bytes written
+    size_t saveTo(Print& out) const {
+        StructaSnapshotHeader header = makeHeader();
+        size_t written = out.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+        size_t first = firstRun();
+        written += out.write(slot(0), first * RECORD_SIZE);
+        if (first < count_) written += out.write(storage_, (count_ - first) * RECORD_SIZE);
+        return written;
+    }
+
+    // The same into a buffer (e.g. for an NVS blob); 0 if it does not fit
+    size_t saveTo(uint8_t* buffer, size_t size) const {
+        if (size < snapshotSize()) return 0;
+        StructaSnapshotHeader header = makeHeader();
+        memcpy(buffer, &header, sizeof(header));
+        uint8_t* out = buffer + sizeof(header);
+        size_t first = firstRun();
+        memcpy(out, slot(0), first * RECORD_SIZE);
+        memcpy(out + first * RECORD_SIZE, storage_, (count_ - first) * RECORD_SIZE);
+        return snapshotSize();
+    }
+
+    // Replaces the contents with a snapshot; data holds the records loaded.
+    // A snapshot of more than N records keeps the newest N. Records are read
+    // into the free slots after the current ones and only take over once the
+    // whole snapshot has arrived, so a stream that ends early leaves the
+    // buffer as it was. A snapshot needing more than the free slots reuses
+    // the oldest records' slots, and a failure then drops only those.
+    SerializationResult<size_t> loadFrom(Stream& in) {
+        StructaSnapshotHeader header;
+        if (in.readBytes(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)) {
+            return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Incomplete snapshot");
+        }
+        const SerializationResult<void> check = checkHeader(header);
+        if (!check.success) return SerializationResult<size_t>::Failure(check.error.code, check.error.message);
+        size_t loaded = 0;
+        for (uint32_t i = 0; i < header.count; ++i) {
+            bool kept = header.count - i <= N;
+            bool read = kept ? readRecord(in, slot(count_ + loaded)) : skipRecord(in);
+            if (!read) {
+                size_t used = loaded + (kept ? 1 : 0);
+                if (used > N - count_) discard(used - (N - count_));
+                return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Incomplete snapshot");
+            }
+            if (kept) ++loaded;
+        }
+        head_ = (head_ + count_) % N;
+        count_ = loaded;
+        return SerializationResult<size_t>::Success(count_);
+    }
+
+    // From a snapshot in memory: an NVS blob, or a flash partition mapped
+    // into the address space
+    SerializationResult<size_t> loadFrom(const uint8_t* snapshot, size_t length) {
+        StructaSnapshotHeader header;
+        if (length < sizeof(header)) {
+            return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Incomplete snapshot");
+        }
+        memcpy(&header, snapshot, sizeof(header));
+        const SerializationResult<void> check = checkHeader(header);
+        if (!check.success) return SerializationResult<size_t>::Failure(check.error.code, check.error.message);
+        if (length - sizeof(header) < (size_t)header.count * RECORD_SIZE) {
+            return SerializationResult<size_t>::Failure(SerializationError::INVALID_JSON, "Incomplete snapshot");
+        }
+        size_t skip = header.count > N ? header.count - N : 0;
+        clear();
+        count_ = header.count - skip;
+        memcpy(storage_, snapshot + sizeof(header) + skip * RECORD_SIZE, count_ * RECORD_SIZE);
+        return SerializationResult<size_t>::Success(count_);
+    }
+
+private:
+    // Unpacks records for the batch writer into one scratch struct
+    struct Records {
+        const StructaRingBuffer& ring;
+        T scratch;
+        explicit Records(const StructaRingBuffer& r) : ring(r), scratch() {}
+        const T& operator[](size_t i) {
+            ring.peek(i, scratch);
+            return scratch;
+        }
+    };
+
+    static bool readRecord(Stream& in, uint8_t* target) {
+        return in.readBytes(reinterpret_cast<char*>(target), RECORD_SIZE) == RECORD_SIZE;
+    }
+
+    // Older records than fit are read through a small chunk, not a record-
+    // sized buffer on the stack
+    static bool skipRecord(Stream& in) {
+        char chunk[32];
+        for (size_t left = RECORD_SIZE; left > 0;) {
+            size_t n = left < sizeof(chunk) ? left : sizeof(chunk);
+            if (in.readBytes(chunk, n) != n) return false;
+            left -= n;
+        }
+        return true;
+    }
+
+    uint8_t* slot(size_t i) { return storage_ + ((head_ + i) % N) * RECORD_SIZE; }
+    const uint8_t* slot(size_t i) const { return storage_ + ((head_ + i) % N) * RECORD_SIZE; }
+
+    StructaSnapshotHeader makeHeader() const {
+        StructaSnapshotHeader header;
+        header.magic = STRUCTA_SNAPSHOT_MAGIC;
+        header.schemaVersion = STRUCTA_SCHEMA_VERSION;
+        header.recordSize = (uint16_t)RECORD_SIZE;
+        header.schemaHash = (uint32_t)T::schemaHash;
+        header.count = (uint32_t)count_;
+        return header;
+    }
+
+    static SerializationResult<void> checkHeader(const StructaSnapshotHeader& header) {
+        if (header.magic != STRUCTA_SNAPSHOT_MAGIC) {
+            return SerializationResult<void>::Failure(SerializationError::INVALID_JSON, "Not a record snapshot");
+        }
+        if (header.schemaVersion != STRUCTA_SCHEMA_VERSION || header.recordSize != RECORD_SIZE) {
+            return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, "Schema version mismatch");
+        }
+        // Same size is not enough: reordered fields or an int32_t turned
+        // float would be misread byte for byte
+        if (header.schemaHash != (uint32_t)T::schemaHash) {
+            return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, "Record layout mismatch");
+        }
+        return SerializationResult<void>::Success();
+    }
+
+    uint8_t storage_[N * RECORD_SIZE];
+    size_t head_;
+    size_t count_;
+    uint32_t dropped_;
+};
+
+// ======================================================
+// Publish Pipeline
+// ======================================================
+// Moves encoding off the sampling loop. publish() copies a snapshot into a
+// lock-free single-producer queue and returns; an encoder drains the queue
+// into one of two preallocated output buffers, reusing one preallocated
+// document, and a sender writes finished buffers to the sink. While one
+// buffer is on its way out the next snapshot is encoded into the other. On
+// ESP32, begin() runs the encoder and sender as tasks pinned to a core
+// (by default core 0, away from the Arduino loop); elsewhere call poll()
+// from the loop. A full queue refuses the snapshot, counts it in dropped()
+// and leaves the queued ones alone. A snapshot whose output does not fit
+// BufferSize bytes is counted in failed() and skipped. Queue figures are
+// in MemoryTracker::printStats(); publish() takes no lock, so its counts
+// reach them the next time the encoder runs. Declare pipelines with static storage:
+// they hold Depth copies of T, both buffers and the document.
+//   static StructaPipeline<Reading, 8, 256> uplink(client, "uplink");
+//   uplink.begin();
+//   ...
+//   uplink.publish(reading);               // from one task only
+
+// Index shared by one writer and one reader: a store publishes what was
+// written before it to the task that loads it
+template<typename T>
+inline T structaLoadAcquire(const T& value) { return __atomic_load_n(&value, __ATOMIC_ACQUIRE); }
+template<typename T>
+inline void structaStoreRelease(T& target, T value) { __atomic_store_n(&target, value, __ATOMIC_RELEASE); }
+
+template<typename T, size_t Depth, size_t BufferSize, typename Format = StructaJsonFormat>
+class StructaPipeline {
+public:
+    static_assert(Depth > 0, "StructaPipeline needs room for at least one snapshot");
+
+    explicit StructaPipeline(Print& out, const char* name = "pipeline")
+        : out_(out), stats_(name, Depth), head_(0), tail_(0), encodeAt_(0), sendAt_(0),
+          dropped_(0), failed_(0), reportedTail_(0), reportedDropped_(0) {
+        ready_[0] = ready_[1] = false;
+        length_[0] = length_[1] = 0;
+#if defined(ESP32)
+        encoder_ = sender_ = nullptr;
+#endif
+    }
+
+#if defined(ESP32)
+    // Starts the encoder and the sender; false if either task could not be created
+    bool begin(BaseType_t core = 0, uint32_t stackSize = 4096, UBaseType_t priority = 1) {
+        if (encoder_) return true;
+        if (xTaskCreatePinnedToCore(encodeTask, "structa-enc", stackSize, this, priority, &encoder_, core) != pdPASS) {
+            encoder_ = nullptr;
+            return false;
+        }
+        if (xTaskCreatePinnedToCore(sendTask, "structa-send", stackSize, this, priority, &sender_, core) != pdPASS) {
+            vTaskDelete(encoder_);
+            encoder_ = sender_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    // Producer side; false if the queue is full. Takes no lock: the tracker
+    // learns of publishes and drops when the encoder next runs.
+    bool publish(const T& value) {
+        size_t tail = tail_;
+        if (tail - structaLoadAcquire(head_) == Depth) {
+            structaStoreRelease(dropped_, dropped_ + 1);
+            return false;
+        }
+        queue_[tail % Depth] = value;
+        structaStoreRelease(tail_, tail + 1);
+        wake(encoder());
+        return true;
+    }
+
+    // Encodes the oldest snapshot into a free buffer; false if there is no
+    // snapshot or both buffers are still waiting to be sent
+    bool encodeNext() {
+        size_t head = head_;
+        size_t tail = structaLoadAcquire(tail_);
+        reportPublished(tail, head);
+        if (tail == head) return false;
+        size_t at = encodeAt_;
+        if (structaLoadAcquire(ready_[at])) {
+            MemoryTracker::recordQueue(stats_, MemoryTracker::QUEUE_STALLED);
+            return false;
+        }
+        SerializationResult<size_t> result =
+            queue_[head % Depth].template serializeWithResult<Format>(context_, buffers_[at], BufferSize);
+        structaStoreRelease(head_, head + 1);
+        if (!result.success) {
+            structaStoreRelease(failed_, failed_ + 1);
+            MemoryTracker::recordQueue(stats_, MemoryTracker::QUEUE_FAILED);
+            return true;
+        }
+        length_[at] = result.data;
+        structaStoreRelease(ready_[at], true);
+        encodeAt_ = at ^ 1;
+        MemoryTracker::recordQueue(stats_, MemoryTracker::QUEUE_ENCODED);
+        wake(sender());
+        return true;
+    }
+
+    // Writes the oldest encoded buffer to the sink; false if none is ready
+    bool sendNext() {
+        size_t at = sendAt_;
+        if (!structaLoadAcquire(ready_[at])) return false;
+        size_t length = length_[at];
+        size_t written = out_.write(reinterpret_cast<const uint8_t*>(buffers_[at]), length);
+        structaStoreRelease(ready_[at], false);
+        sendAt_ = at ^ 1;
+        MemoryTracker::recordQueue(stats_, written == length ? MemoryTracker::QUEUE_SENT : MemoryTracker::QUEUE_FAILED);
+        wake(encoder());
+        return true;
+    }
+
+    // Without tasks: encodes and sends everything queued; returns the
+    // snapshots handled
+    size_t poll() {
+        size_t handled = 0;
+        for (;;) {
+            bool encoded = encodeNext();
+            bool sent = sendNext();
+            if (!encoded && !sent) return handled;
+            if (encoded) ++handled;
+        }
+    }
+
+    size_t queued() const { return structaLoadAcquire(tail_) - structaLoadAcquire(head_); }
+    static constexpr size_t capacity() { return Depth; }
+    uint32_t dropped() const { return structaLoadAcquire(dropped_); }
+    uint32_t failed() const { return structaLoadAcquire(failed_); }
+
+private:
+    // Encoder side: hands the tracker what the producer did since the last
+    // call. Only the encoder shortens the queue, so tail - head sampled here
+    // still reaches the longest queue the producer built.
+    void reportPublished(size_t tail, size_t head) {
+        uint32_t dropped = structaLoadAcquire(dropped_);
+        if (tail == reportedTail_ && dropped == reportedDropped_) return;
+        MemoryTracker::recordPublished(stats_, tail - reportedTail_, dropped - reportedDropped_, tail - head);
+        reportedTail_ = tail;
+        reportedDropped_ = dropped;
+    }
+
+#if defined(ESP32)
+    TaskHandle_t encoder() const { return encoder_; }
+    TaskHandle_t sender() const { return sender_; }
+    static void wake(TaskHandle_t task) {
+        if (task) xTaskNotifyGive(task);
+    }
+
+    // Notifications are counted, so one given before the task blocks is not lost
+    static void encodeTask(void* self) {
+        StructaPipeline& pipeline = *static_cast<StructaPipeline*>(self);
+        for (;;) {
+            if (!pipeline.encodeNext()) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    static void sendTask(void* self) {
+        StructaPipeline& pipeline = *static_cast<StructaPipeline*>(self);
+        for (;;) {
+            if (!pipeline.sendNext()) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    TaskHandle_t encoder_;
+    TaskHandle_t sender_;
+#else
+    void* encoder() const { return nullptr; }
+    void* sender() const { return nullptr; }
+    static void wake(void*) {}
+#endif
+
+    Print& out_;
+    MemoryTracker::QueueStats stats_;
+    StructaFixedContext<T::jsonCapacity> context_;   // encoder only
+    T queue_[Depth];
+    size_t head_;                                    // written by the encoder
+    size_t tail_;                                    // written by the producer
+    char buffers_[2][BufferSize];
+    size_t length_[2];
+    bool ready_[2];                                  // set by the encoder, cleared by the sender
+    size_t encodeAt_;
+    size_t sendAt_;
+    uint32_t dropped_;                               // written by the producer
+    uint32_t failed_;                                // written by the encoder
+    size_t reportedTail_;                            // encoder only
+    uint32_t reportedDropped_;                       // encoder only
+};
+
+// ======================================================
+// Macros
+// ======================================================
+// Each field is field(type, name) or field(type, name, META_...); the rule is
+// a trailing variadic argument, read by the field-rule macros further down and,
+// for its numeric encoding, through STRUCTA_CODED by the value macros here
+#define DECLARE(type, name, ...) StructaFieldType<type>::declared name;
+#define SERIALIZE_FIELD(type, name, ...) serializeField(obj, STRUCTA_KEY(#name), STRUCTA_CODED(name, __VA_ARGS__));
+#define DESERIALIZE_FIELD(type, name, ...) deserializeField(o, STRUCTA_KEY(#name), data.name);
+#define PARSE_CASE(type, name, ...) \
+    case StructaKey::hash(#name): \
+        static_assert(sizeof(#name) <= STRUCTA_MAX_KEY_LENGTH + 1, "field name longer than STRUCTA_MAX_KEY_LENGTH"); \
+        if (STRUCTA_KEY_EQUALS(key, #name)) { \
+            if (!r.read(STRUCTA_CODED(data.name, __VA_ARGS__))) return false; \
+            continue; \
+        } \
+        break;
+#define DESERIALIZE_CASE(type, name, ...) \
+    case StructaKey::hash(#name): \
+        if (STRUCTA_KEY_EQUALS(key, #name)) readField(kv.value(), STRUCTA_CODED(data.name, __VA_ARGS__)); \
+        break;
+#define SAME_FIELD(type, name, ...) && sameValue(a.name, b.name)
+#define CHANGED_FIELD_BIT(type, name, ...) if (!sameValue(name, since.name)) mask |= bit; bit <<= 1;
+#define FIELD_HAS_FIXED_TEXT(type, name, ...) \
+    || (structaMeta(__VA_ARGS__).scale > 0 && structaMeta(__VA_ARGS__).decimals > 0) \
+    || StructaHasFixedText<StructaFieldType<type>::declared>::value
+#define FIXED_AS_NUMBER(type, name, ...) fixedAsNumber(obj, STRUCTA_KEY(#name), STRUCTA_CODED(name, __VA_ARGS__));
+#define SERIALIZE_CHANGED(type, name, ...) \
+    serializeChanged(obj, STRUCTA_KEY(#name), STRUCTA_CODED(name, __VA_ARGS__), since.name);
+#define FILTER_FIELD(type, name, ...) \
+    filterField(filter, STRUCTA_KEY(#name), static_cast<const StructaFieldType<type>::declared*>(nullptr));
+#define VISIT_FIELD(type, name, ...) visitor(STRUCTA_KEY(#name), name);
+#define VISIT_FIELD_TYPE(type, name, ...) \
+    visitor(STRUCTA_KEY(#name), static_cast<const StructaFieldType<type>::declared*>(nullptr));
+#define SCHEMA_NAME_TEXT(type, name, ...) #name "\0"
+#define SCHEMA_NAME_OFFSET(type, name, ...) NAME_AT_##name, NAME_END_##name = NAME_AT_##name + sizeof(#name) - 1,
+#define DESCRIBE_FIELD(type, name, ...) \
+    FieldTraits<STRUCTA_CODED_TYPE(type, __VA_ARGS__)>::describe(NAME_AT_##name, StructaKey::hash(#name), offsetof(StructaSelf, name)),
+#define SERIALIZE_ELEMENT(type, name, ...) serializeElement(arr, STRUCTA_CODED(name, __VA_ARGS__));
+#define DESERIALIZE_ELEMENT(type, name, ...) deserializeElement(it, end, STRUCTA_CODED(data.name, __VA_ARGS__));
+
+// Capacity estimate: one slot per member, the key text, plus whatever the value needs.
+// SIZE_HINTS(hint) lists hint(fieldName, expectedLength) for String fields that
+// differ from STRUCTA_DEFAULT_STRING_SIZE.
+#define STRUCTA_NO_HINTS(hint)
+#define DECLARE_STRING_HINT(type, name, ...) static constexpr size_t name = STRUCTA_DEFAULT_STRING_SIZE;
+#define OVERRIDE_STRING_HINT(name, size) static constexpr size_t name = (size);
+#define CAPACITY_FIELD(type, name, ...) \
+    + JSON_OBJECT_SIZE(1) + sizeof(#name) + StructaFieldCapacity<STRUCTA_CODED_TYPE(type, __VA_ARGS__)>::get(CapacityHints::name)
+#define FILTER_CAPACITY_FIELD(type, name, ...) \
+    + JSON_OBJECT_SIZE(1) + STRUCTA_KEY_SIZE(#name) + StructaFilterCapacity<type>::get()
+// Bytes of the struct's packed record (see Record Buffers)
+#define PACKED_SIZE_FIELD(type, name, ...) + StructaPackedSize<type>::value
+#define DECLARE_CAPACITY(FIELD_LIST, SIZE_HINTS) \
+    struct DefaultCapacityHints { FIELD_LIST(DECLARE_STRING_HINT) }; \
+    struct CapacityHints : DefaultCapacityHints { SIZE_HINTS(OVERRIDE_STRING_HINT) }; \
+    static constexpr size_t jsonCapacity = 0 FIELD_LIST(CAPACITY_FIELD); \
+    typedef StructaDocument<jsonCapacity> Document; \
+    static constexpr size_t compactCapacity = jsonCapacity + JSON_ARRAY_SIZE(2); \
+    typedef StructaDocument<compactCapacity> CompactDocument; \
+    static constexpr size_t filterCapacity = 0 FIELD_LIST(FILTER_CAPACITY_FIELD); \
+    static constexpr size_t packedSize = 0 FIELD_LIST(PACKED_SIZE_FIELD);
+
+#if STRUCTA_VALIDATION
+// NEW: Simple validation macros that avoid comma issues
+// Validators live in per-type constexpr accessors rather than in each instance
+#define DECLARE_VALIDATOR(fieldName, validatorInstance) \
+    static constexpr decltype(validatorInstance) validator_##fieldName() { return validatorInstance; }
+#define VALIDATE_FIELD(fieldName, validatorInstance) \
+    { \
+        String errMsg; \
+        if (!validator_##fieldName().validate(#fieldName, fieldName, errMsg)) { \
+            return SerializationResult<bool>::Failure( \
+                SerializationError::VALIDATION_FAILED, errMsg, #fieldName); \
+        } \
+    }
+
+// Helper functions to create validators without comma issues
+constexpr RangeValidator<int> makeRangeValidatorInt(int min, int max) {
+    return RangeValidator<int>(min, max);
+}
+
+constexpr RangeValidator<float> makeRangeValidatorFloat(float min, float max) {
+    return RangeValidator<float>(min, max);
+}
+
+constexpr StringLengthValidator makeStringLengthValidator(size_t min, size_t max) {
+    return StringLengthValidator(min, max);
+}
+
+constexpr StringLengthValidator makeStringMinLengthValidator(size_t min) {
+    return StringLengthValidator::minLength(min);
+}
+
+constexpr StringLengthValidator makeStringMaxLengthValidator(size_t max) {
+    return StringLengthValidator::maxLength(max);
+}
+
+constexpr RequiredValidator makeRequiredValidator() {
+    return RequiredValidator();
+}
+
+template<typename T>
+constexpr CustomValidator<T> makeCustomValidator(bool (*func)(T), const char* errorMsg = "Custom validation failed") {
+    return CustomValidator<T>(func, errorMsg);
+}
+
+// Field rules: the optional third argument of each field (see Field Rules)
+#define FIELD_HAS_RULE(type, name, ...) || structaMeta(__VA_ARGS__).validate
+#define SCHEMA_ENTRY(type, name, ...) \
+    makeFieldSchema(names + NAME_AT_##name, StructaTypeResolver<StructaFieldType<type>::declared>::value, structaMeta(__VA_ARGS__)),
+#define DECLARE_RULE(type, name, ...) \
+    struct Rule_##name { static constexpr FieldMeta meta() { return structaMeta(__VA_ARGS__); } };
+#define VALIDATE_MEMBER(type, name, ...) \
+    if (const char* problem = StructaRule<Rule_##name>::member(STRUCTA_CODED(name, __VA_ARGS__))) \
+        return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, problem, schemaName(FIELD_##name));
+#define COLLECT_MEMBER_ERROR(type, name, ...) \
+    if (const char* problem = StructaRule<Rule_##name>::member(STRUCTA_CODED(name, __VA_ARGS__))) \
+        errors.add(FIELD_##name, SerializationError::TYPE_MISMATCH, problem);
+#define CHECK_VALUE_CASE(type, name, ...) \
+    case FIELD_##name: return StructaRule<Rule_##name>::value<StructaFieldType<type>::declared>(v);
+#define CHECK_MISSING_CASE(type, name, ...) \
+    case FIELD_##name: return StructaRule<Rule_##name>::missing();
+
+// printSchema(); an empty stub with STRUCTA_INTROSPECTION 0
+#if STRUCTA_INTROSPECTION
+#define STRUCTA_SCHEMA_PRINTER(structName)                                   \
+    static void printSchema(Print& out = Serial) {                           \
+        out.println(STRUCTA_TEXT("=== " #structName " Schema ==="));         \
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {                           \
+            FieldSchema f = schemaEntry(i);                                  \
+            out.print(STRUCTA_TEXT(" - "));                                  \
+            out.print(STRUCTA_FLASH(f.name));                                \
+            out.print(STRUCTA_TEXT(" ["));                                   \
+            switch (f.type) {                                                \
+                case FieldType::INT: out.print(STRUCTA_TEXT("int")); break;  \
+                case FieldType::FLOAT: out.print(STRUCTA_TEXT("float")); break; \
+                case FieldType::BOOL: out.print(STRUCTA_TEXT("bool")); break; \
+                case FieldType::STRING: out.print(STRUCTA_TEXT("string")); break; \
+                case FieldType::OBJECT: out.print(STRUCTA_TEXT("object")); break; \
+                default: out.print(STRUCTA_TEXT("unknown")); }               \
+            out.print(STRUCTA_TEXT("]"));                                    \
+            if (!f.required) out.print(STRUCTA_TEXT(" (optional)"));         \
+            if (!f.validate) out.print(STRUCTA_TEXT(" (unvalidated)"));      \
+            if (f.decimals) {                                                \
+                out.print(STRUCTA_TEXT(" (fixed "));                         \
+                out.print(f.decimals);                                       \
+                out.print(STRUCTA_TEXT(")"));                                \
+            } else if (f.scale) {                                            \
+                out.print(STRUCTA_TEXT(" (scaled x"));                       \
+                out.print((long)f.scale);                                    \
+                out.print(STRUCTA_TEXT(")"));                                \
+            }                                                                \
+            out.println();                                                   \
+        }                                                                    \
+        out.println(STRUCTA_TEXT("==========================="));            \
+    }
+#else
+#define STRUCTA_SCHEMA_PRINTER(structName) static void printSchema(Print& = Serial) {}
+#endif
+#else
+#define DECLARE_VALIDATOR(fieldName, validatorInstance)
+#define VALIDATE_FIELD(fieldName, validatorInstance)
+#endif // STRUCTA_VALIDATION
+
+#define STRUCTA_PRINTER_STUBS                                                \
+    static void printStructDefinition(Print& = Serial) {}                    \
+    static void printFieldInfo(Print& = Serial) {}                           \
+    void printCurrentValues(Print& = Serial) const {}
+
+// Position of each field in FIELD_LIST (and in the schema table) as
+// FIELD_<name>, and of a key as fieldIndex(key), -1 if unknown
+#define FIELD_INDEX_ENUM(type, name, ...) FIELD_##name,
+#define FIELD_INDEX_CASE(type, name, ...) \
+    case StructaKey::hash(#name): return STRUCTA_KEY_EQUALS(key, #name) ? FIELD_##name : -1;
+#define STRUCTA_FIELD_INDEX(FIELD_LIST)                                      \
+    enum FieldIndex { FIELD_LIST(FIELD_INDEX_ENUM) FIELD_COUNT };            \
+    static int fieldIndex(const char* key) {                                 \
+        switch (StructaKey::hashRuntime(key)) {                              \
+            FIELD_LIST(FIELD_INDEX_CASE)                                     \
+            default: return -1;                                              \
+        }                                                                    \
+    }
+
+// schemaHash and the per-field tables a peer's StructaSchemaCache is built
+// from (see Schema Fingerprint)
+#define SCHEMA_FIELD_KIND(type, name, ...) StructaTypeHash<STRUCTA_CODED_TYPE(type, __VA_ARGS__)>::value
+#define SCHEMA_HASH_FIELD(type, name, ...) \
+    , structaMix(StructaKey::hash(#name), SCHEMA_FIELD_KIND(type, name, __VA_ARGS__))
+#define SCHEMA_INDEX_CASE(type, name, ...) case StructaKey::hash(#name): return FIELD_##name;
+#define SCHEMA_KIND_CASE(type, name, ...) case FIELD_##name: return SCHEMA_FIELD_KIND(type, name, __VA_ARGS__);
+#define SCHEMA_DESCRIBE_FIELD(type, name, ...) \
+    arr.add((uint32_t)StructaKey::hash(#name)); \
+    arr.add((uint32_t)SCHEMA_FIELD_KIND(type, name, __VA_ARGS__));
+#define MAPPED_ELEMENT_CASE(type, name, ...) \
+    case FIELD_##name: deserializeElement(it, end, STRUCTA_CODED(data.name, __VA_ARGS__)); break;
+#define STRUCTA_SCHEMA_MAP(structName, FIELD_LIST)                           \
+    static constexpr uint32_t schemaHash = structaFold(2166136261u FIELD_LIST(SCHEMA_HASH_FIELD)); \
+    typedef StructaDocument<JSON_ARRAY_SIZE(2 + 2 * FIELD_COUNT)> SchemaDocument; \
+                                                                             \
+    /* Field with the name hashed to nameHash, -1 if there is none */        \
+    static int fieldIndexByHash(uint32_t nameHash) {                         \
+        switch (nameHash) {                                                  \
+            FIELD_LIST(SCHEMA_INDEX_CASE)                                    \
+            default: return -1;                                              \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    /* StructaTypeHash of the i-th field as it is coded in frames */         \
+    static uint32_t fieldKind(int i) {                                       \
+        switch (i) {                                                         \
+            FIELD_LIST(SCHEMA_KIND_CASE)                                     \
+            default: return 0;                                               \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    /* [STRUCTA_SCHEMA_VERSION, schemaHash, name hash, kind, ...] */         \
+    static void describeSchema(JsonDocument& doc) {                          \
+        JsonArray arr = doc.to<JsonArray>();                                 \
+        arr.add(STRUCTA_SCHEMA_VERSION);                                     \
+        arr.add((uint32_t)schemaHash);                                       \
+        FIELD_LIST(SCHEMA_DESCRIBE_FIELD)                                    \
+    }                                                                        \
+                                                                             \
+    /* What a peer's StructaSchemaCache learns this firmware's frames from */ \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<size_t> serializeSchema(char* buffer, size_t size) { \
+        SchemaDocument doc;                                                  \
+        describeSchema(doc);                                                 \
+        return writeOutput<Format>(doc, buffer, size);                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<size_t> serializeSchema(Print& out) {         \
+        SchemaDocument doc;                                                  \
+        describeSchema(doc);                                                 \
+        return writeOutput<Format>(doc, out);                                \
+    }                                                                        \
+                                                                             \
+    /* Frame elements of a peer's schema, each into the field map names */   \
+    static void deserializeMappedFields(JsonArray::iterator it, const JsonArray::iterator& end, \
+                                        structName& data, const StructaFieldMap& map) { \
+        for (size_t i = 0; i < map.count && it != end; ++i) {                \
+            switch (map.field[i]) {                                          \
+                FIELD_LIST(MAPPED_ELEMENT_CASE)                              \
+                default: ++it;                                               \
+            }                                                                \
+        }                                                                    \
+    }
+
+// View over a parsed object or raw JSON text: each getter decodes only its
+// own field and returns the member's default when the key is missing. Over
+// raw text the first call notes where every value starts in one pass, and a
+// getter then parses from there; nothing else is decoded or copied. Getters
+// check no rules; materialize() decodes the whole struct with them. The
+// object or text must outlive the view.
+#define VIEW_GETTER(type, name, ...)                                         \
+    StructaViewValue<StructaFieldType<type>::declared>::Value name() const { \
+        StructaViewValue<StructaFieldType<type>::declared>::Value value =    \
+            StructaViewValue<StructaFieldType<type>::declared>::Value();     \
+        load(FIELD_##name, STRUCTA_KEY(#name),                               \
+             STRUCTA_CODED(value, __VA_ARGS__));                             \
+        return value;                                                        \
+    }
+#define STRUCTA_VIEW(structName, FIELD_LIST)                                 \
+    class View {                                                             \
+    public:                                                                  \
+        explicit View(const JsonObject& object)                              \
+            : object_(object), json_(nullptr), end_(nullptr), indexed_(false), error_(nullptr) {} \
+        View(const char* json, size_t length)                                \
+            : json_(json), end_(json + length), indexed_(false), error_(nullptr) {} \
+                                                                             \
+        FIELD_LIST(VIEW_GETTER)                                              \
+                                                                             \
+        bool contains(const char* key) const {                               \
+            int slot = fieldIndex(key);                                      \
+            if (slot < 0) return false;                                      \
+            if (!json_) return object_.containsKey(key);                     \
+            index();                                                         \
+            return at_[slot] != nullptr;                                     \
+        }                                                                    \
+                                                                             \
+        /* nullptr, or why the raw text could not be scanned */              \
+        const char* error() const {                                          \
+            if (json_) index();                                              \
+            return error_;                                                   \
+        }                                                                    \
+                                                                             \
+        /* What was wrapped, e.g. to forward a message untouched */          \
+        const JsonObject& object() const { return object_; }                 \
+        const char* data() const { return json_; }                           \
+        size_t length() const { return end_ - json_; }                       \
+                                                                             \
+        /* The whole struct, with the same checks as a full read */          \
+        SerializationResult<structName> materialize() const {                \
+            SerializationResult<structName> result;                          \
+            if (json_) result.setStatus(deserializeDirectInto(result.data, json_, length())); \
+            else result.setStatus(deserializeInto(result.data, object_));    \
+            return result;                                                   \
+        }                                                                    \
+                                                                             \
+    private:                                                                 \
+        /* Where each value starts in the raw text, in one pass on first use */ \
+        void index() const {                                                 \
+            if (indexed_) return;                                            \
+            indexed_ = true;                                                 \
+            for (size_t i = 0; i < FIELD_COUNT; ++i) at_[i] = nullptr;        \
+            StructaReader reader(json_, length());                           \
+            StructaReader::Key key;                                          \
+            bool first = true;                                               \
+            if (reader.beginObject()) {                                      \
+                while (reader.nextMember(key, first)) {                      \
+                    int slot = fieldIndex(key);                              \
+                    if (slot >= 0) at_[slot] = reader.position();            \
+                    if (!reader.skipValue()) break;                          \
+                }                                                            \
+            }                                                                \
+            error_ = reader.error();                                         \
+        }                                                                    \
+                                                                             \
+        template<typename T>                                                 \
+        void load(int slot, StructaKeyText key, T&& value) const {           \
+            if (!json_) {                                                    \
+                JsonVariant v = object_[key];                                \
+                readField(v, value);                                         \
+                return;                                                      \
+            }                                                                \
+            index();                                                         \
+            if (!at_[slot]) return;                                          \
+            StructaReader reader(at_[slot], end_ - at_[slot]);               \
+            reader.read(value);                                              \
+        }                                                                    \
+                                                                             \
+        JsonObject object_;                                                  \
+        const char* json_;                                                   \
+        const char* end_;                                                    \
+        mutable const char* at_[FIELD_COUNT];                                 \
+        mutable bool indexed_;                                               \
+        mutable const char* error_;                                          \
+    };
+
+// Introspection printers; with STRUCTA_INTROSPECTION 0 they are empty stubs
+#if STRUCTA_INTROSPECTION
+#define STRUCTA_PRINTERS(structName)                                         \
+    static void printStructDefinition(Print& out = Serial) {                 \
+        out.println(STRUCTA_TEXT("=== " #structName " Struct Definition ===")); \
+        out.println(STRUCTA_TEXT("Struct Name: " #structName));              \
+        out.println(STRUCTA_TEXT("Generated Methods:"));                     \
+        out.println(STRUCTA_TEXT("  - serialize() -> String"));              \
+        out.println(STRUCTA_TEXT("  - serializeWithResult() -> SerializationResult<String>")); \
+        out.println(STRUCTA_TEXT("  - serializeDelta(since[, out]) / applyPatch(json) (changed fields only)")); \
+        out.println(STRUCTA_TEXT("  - jsonFilter() -> const JsonDocument& (declared keys kept while parsing)")); \
+        out.println(STRUCTA_TEXT("  - jsonFilterComplete() -> bool (false if filterCapacity dropped keys)")); \
+        out.println(STRUCTA_TEXT("  - serialize(char*, size_t) / serialize(Print&) -> size_t")); \
+        out.println(STRUCTA_TEXT("  - serializeWithResult(char*, size_t) / (Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - serializeInto(JsonObject&) -> void")); \
+        out.println(STRUCTA_TEXT("  - deserialize(String) -> " #structName)); \
+        out.println(STRUCTA_TEXT("  - deserialize(JsonObject) -> " #structName)); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(String) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(JsonObject) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(const char* | uint8_t*, size_t | Stream&) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeInPlace(char*, size_t) -> SerializationResult<" #structName "> (zero-copy)")); \
+        out.println(STRUCTA_TEXT("  - deserializeDirect(const char*, size_t | Stream&) -> SerializationResult<" #structName "> (no document)")); \
+        out.println(STRUCTA_TEXT("  - deserializeInto(" #structName "&, input) -> SerializationResult<void> (fills an existing instance)")); \
+        out.println(STRUCTA_TEXT("  - View(JsonObject | const char*, size_t): lazy getters, contains(), materialize()")); \
+        out.println(STRUCTA_TEXT("  - serializeWithResult(StructaContext&[, out]) / deserializeInto(StructaContext&, ...) (reuse a document)")); \
+        out.println(STRUCTA_TEXT("  - serializeMsgPack(uint8_t*, size_t | Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeMsgPack(const uint8_t*, size_t | Stream&) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - serializeCompact<Format>(char*, size_t | Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - serializeBatch<Format>(const " #structName "*, size_t, Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeBatch(Stream&, " #structName "*, size_t) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeCompact<Format>(const uint8_t*, size_t | Stream&[, StructaSchemaCache&]) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - serializeSchema<Format>(char*, size_t | Print&) -> SerializationResult<size_t> (for a peer's StructaSchemaCache)")); \
+        out.println(STRUCTA_TEXT("  - forEachField(visitor) / forEachFieldType(visitor) (typed field walk)")); \
+        out.println(STRUCTA_TEXT("  - printStructDefinition(Print& = Serial) -> void")); \
+        out.println(STRUCTA_TEXT("  - printFieldInfo(Print& = Serial) / printCurrentValues(Print& = Serial) -> void")); \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Usage Example:"));                         \
+        out.println(STRUCTA_TEXT("  " #structName " obj;"));                 \
+        out.println(STRUCTA_TEXT("  String json = obj.serialize();"));       \
+        out.println(STRUCTA_TEXT("  " #structName " copy = " #structName "::deserialize(json);")); \
+        out.println(STRUCTA_TEXT("=======================================")); \
+    }                                                                        \
+                                                                             \
+    static void printFieldInfo(Print& out = Serial) {                        \
+        out.println(STRUCTA_TEXT("=== " #structName " Field Information ===")); \
+        out.println(STRUCTA_TEXT("Fields:"));                                \
+        forEachFieldType(StructaFieldInfoPrinter(out));                      \
+        out.print(STRUCTA_TEXT("Document capacity: "));                      \
+        out.print((unsigned long)jsonCapacity);                              \
+        out.println(STRUCTA_TEXT(" bytes"));                                 \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("For detailed macro writing guide, call:")); \
+        out.println(STRUCTA_TEXT("MemoryTracker::showMacroWritingGuide();")); \
+        out.println(STRUCTA_TEXT("=========================================")); \
+    }                                                                        \
+                                                                             \
+    /* Streams the JSON and one line per field; no String or parse involved */ \
+    void printCurrentValues(Print& out = Serial) const {                     \
+        out.println(STRUCTA_TEXT("=== " #structName " Current Values ===")); \
+        out.println(STRUCTA_TEXT("JSON Representation:"));                   \
+        serialize(out);                                                      \
+        out.println();                                                       \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Formatted Output:"));                      \
+        MemoryTracker::recordOperation(memoryStats(), MemoryTracker::DIAGNOSTIC, 0, 0); \
+        forEachField(StructaFieldPrinter(out));                              \
+        out.println(STRUCTA_TEXT("====================================="));  \
+    }
+#else
+#define STRUCTA_PRINTERS(structName) STRUCTA_PRINTER_STUBS
+#endif
+
+// Methods that either expand per field or call the descriptor engine,
+// chosen by STRUCTA_INLINE_FIELDS where the struct is defined. Only the
+// chosen overload is odr-used, so the other is never emitted.
+#define STRUCTA_FIELD_METHODS(structName, FIELD_LIST)                        \
+    typedef structName StructaSelf;                                          \
+    typedef std::integral_constant<bool, STRUCTA_INLINE_FIELDS> InlineFields; \
+    enum NameOffset { FIELD_LIST(SCHEMA_NAME_OFFSET) NAME_BLOCK_SIZE };      \
+                                                                             \
+    /* Constant field table the shared engine walks */                       \
+    static const StructaDescriptor& descriptor() {                           \
+        static_assert(sizeof(structName) <= 0xFFFF, "struct too large for a field table"); \
+        STRUCTA_OFFSETS_BEGIN                                                \
+        static const char names[] STRUCTA_PROGMEM = FIELD_LIST(SCHEMA_NAME_TEXT); \
+        static const StructaField fields[] STRUCTA_PROGMEM = { FIELD_LIST(DESCRIBE_FIELD) }; \
+        STRUCTA_OFFSETS_END                                                  \
+        static const StructaDescriptor table = {                             \
+            names, fields, (uint8_t)(sizeof(fields) / sizeof(fields[0])) };  \
+        return table;                                                        \
+    }                                                                        \
+                                                                             \
+    void serializeInto(JsonObject& obj) const { serializeInto(obj, InlineFields()); } \
+    void serializeInto(JsonObject& obj, std::true_type) const {              \
+        FIELD_LIST(SERIALIZE_FIELD)                                          \
+    }                                                                        \
+    void serializeInto(JsonObject& obj, std::false_type) const {             \
+        tableWrite(descriptor(), obj, this);                                 \
+    }                                                                        \
+                                                                             \
+    /* META_FIXED values (here or in nested structs) are decimal text in */  \
+    /* the document; formats other than JSON get them as numbers instead */  \
+    enum { HAS_FIXED_TEXT = false FIELD_LIST(FIELD_HAS_FIXED_TEXT) };        \
+    void fixedAsNumbers(JsonObject& obj) const {                             \
+        FIELD_LIST(FIXED_AS_NUMBER)                                          \
+    }                                                                        \
+                                                                             \
+    /* One pass over the object; each key is routed by its hash */           \
+    static void deserializeFields(const JsonObject& o, structName& data) {   \
+        deserializeFields(o, data, InlineFields());                          \
+    }                                                                        \
+    static void deserializeFields(const JsonObject& o, structName& data, std::true_type) { \
+        for (JsonPair kv : o) {                                              \
+            const char* key = kv.key().c_str();                              \
+            switch (StructaKey::hashRuntime(key)) {                          \
+                FIELD_LIST(DESERIALIZE_CASE)                                 \
+                default: break;                                              \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+    static void deserializeFields(const JsonObject& o, structName& data, std::false_type) { \
+        tableRead(descriptor(), o, &data);                                   \
+    }                                                                        \
+                                                                             \
+    /* Delta against a snapshot the caller keeps, e.g. the last value sent */ \
+    static bool sameFields(const structName& a, const structName& b) {       \
+        return sameFields(a, b, InlineFields());                             \
+    }                                                                        \
+    static bool sameFields(const structName& a, const structName& b, std::true_type) { \
+        return true FIELD_LIST(SAME_FIELD);                                  \
+    }                                                                        \
+    static bool sameFields(const structName& a, const structName& b, std::false_type) { \
+        return tableSame(descriptor(), &a, &b);                              \
+    }                                                                        \
+                                                                             \
+    /* Bit i is set when the i-th field differs; ChangeMask stays uint32_t */ \
+    /* up to 32 fields and widens to uint64_t above that. Only calling */    \
+    /* changedFields() on a struct of more than 64 fields fails to compile */ \
+    typedef std::conditional<(FIELD_COUNT <= 32), uint32_t, uint64_t>::type ChangeMask; \
+    template<size_t Count = FIELD_COUNT>                                     \
+    ChangeMask changedFields(const structName& since) const {                \
+        static_assert(Count <= 64, "changedFields() tracks at most 64 fields"); \
+        return changedFields(since, InlineFields());                         \
+    }                                                                        \
+    ChangeMask changedFields(const structName& since, std::true_type) const { \
+        ChangeMask mask = 0, bit = 1;                                        \
+        FIELD_LIST(CHANGED_FIELD_BIT)                                        \
+        return mask;                                                         \
+    }                                                                        \
+    ChangeMask changedFields(const structName& since, std::false_type) const { \
+        return (ChangeMask)tableChanged(descriptor(), this, &since);         \
+    }                                                                        \
+                                                                             \
+    void serializeDeltaInto(JsonObject& obj, const structName& since) const { \
+        serializeDeltaInto(obj, since, InlineFields());                      \
+    }                                                                        \
+    void serializeDeltaInto(JsonObject& obj, const structName& since, std::true_type) const { \
+        FIELD_LIST(SERIALIZE_CHANGED)                                        \
+    }                                                                        \
+    void serializeDeltaInto(JsonObject& obj, const structName& since, std::false_type) const { \
+        tableWriteDelta(descriptor(), obj, this, &since);                    \
+    }                                                                        \
+                                                                             \
+    /* Inbound filter built once from FIELD_LIST: keys the struct does */    \
+    /* not declare are skipped while parsing instead of taking pool space */ \
+    static void buildFilter(JsonObject& filter) { buildFilter(filter, InlineFields()); } \
+    static void buildFilter(JsonObject& filter, std::true_type) {            \
+        FIELD_LIST(FILTER_FIELD)                                             \
+    }                                                                        \
+    static void buildFilter(JsonObject& filter, std::false_type) {           \
+        tableFilter(descriptor(), filter);                                   \
+    }
+
+// Rule checks generated from the optional META argument of each field.
+// With STRUCTA_VALIDATION 0 only stubs that always succeed remain.
+#if STRUCTA_VALIDATION
+#define STRUCTA_FIELD_RULES(structName, FIELD_LIST)                          \
+    /* True when any field carries a checked rule; false folds every check away */ \
+    enum { HAS_RULES = false FIELD_LIST(FIELD_HAS_RULE) };                   \
+                                                                             \
+    /* Each field's rule as a type; its checks are specialized from it */    \
+    FIELD_LIST(DECLARE_RULE)                                                 \
+                                                                             \
+    static const char* checkValue(int i, JsonVariant v) {                    \
+        switch (i) {                                                         \
+            FIELD_LIST(CHECK_VALUE_CASE)                                     \
+            default: return nullptr;                                         \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    static const char* checkMissing(int i) {                                 \
+        switch (i) {                                                         \
+            FIELD_LIST(CHECK_MISSING_CASE)                                   \
+            default: return nullptr;                                         \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    /* Names and rules for printSchema() and error lists; constant- */       \
+    /* initialized, so both tables can sit in flash */                       \
+    static const FieldSchema* getSchema(size_t& count) {                     \
+        static const char names[] STRUCTA_PROGMEM = FIELD_LIST(SCHEMA_NAME_TEXT); \
+        static const FieldSchema schema[] STRUCTA_PROGMEM = { FIELD_LIST(SCHEMA_ENTRY) }; \
+        count = FIELD_COUNT;                                                 \
+        return schema;                                                       \
+    }                                                                        \
+                                                                             \
+    static FieldSchema schemaEntry(size_t i) {                               \
+        size_t n;                                                            \
+        return structaLoadSchema(getSchema(n) + i);                          \
+    }                                                                        \
+                                                                             \
+    static String schemaName(size_t i) {                                     \
+        return String(STRUCTA_FLASH(schemaEntry(i).name));                   \
+    }                                                                        \
+                                                                             \
+    /* Checks the members as they are; the first broken rule fails */        \
+    SerializationResult<void> validateSelf() const {                         \
+        FIELD_LIST(VALIDATE_MEMBER)                                          \
+        return SerializationResult<void>::Success();                         \
+    }                                                                        \
+                                                                             \
+    /* One pass over the object, then required fields that never appeared */ \
+    static SerializationResult<void> validateSchema(const JsonObject& o) {   \
+        bool seen[FIELD_COUNT] = {};                                         \
+        for (JsonPair kv : o) {                                              \
+            int i = fieldIndex(kv.key().c_str());                            \
+            if (i < 0) continue;                                             \
+            seen[i] = true;                                                  \
+            if (const char* problem = checkValue(i, kv.value()))             \
+                return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, problem, schemaName(i)); \
+        }                                                                    \
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {                           \
+            if (seen[i]) continue;                                           \
+            if (const char* problem = checkMissing(i))                       \
+                return SerializationResult<void>::Failure(SerializationError::FIELD_MISSING, problem, schemaName(i)); \
+        }                                                                    \
+        return SerializationResult<void>::Success();                         \
+    }                                                                        \
+                                                                             \
+    /* Keys a patch carries; those it leaves out keep their current value */ \
+    static SerializationResult<void> validatePatch(const JsonObject& o) {    \
+        for (JsonPair kv : o) {                                              \
+            int i = fieldIndex(kv.key().c_str());                            \
+            if (i < 0) continue;                                             \
+            if (const char* problem = checkValue(i, kv.value()))             \
+                return SerializationResult<void>::Failure(SerializationError::TYPE_MISMATCH, problem, schemaName(i)); \
+        }                                                                    \
+        return SerializationResult<void>::Success();                         \
+    }                                                                        \
+                                                                             \
+    /* Collect-all variants: record every failing field, true when none failed */ \
+    bool validateSelf(StructaErrorList& errors) const {                      \
+        size_t count;                                                        \
+        errors.schema = getSchema(count);                                    \
+        FIELD_LIST(COLLECT_MEMBER_ERROR)                                     \
+        return errors.empty();                                               \
+    }                                                                        \
+                                                                             \
+    static bool validateSchema(const JsonObject& o, StructaErrorList& errors) { \
+        size_t count;                                                        \
+        errors.schema = getSchema(count);                                    \
+        bool seen[FIELD_COUNT] = {};                                         \
+        for (JsonPair kv : o) {                                              \
+            int i = fieldIndex(kv.key().c_str());                            \
+            if (i < 0) continue;                                             \
+            seen[i] = true;                                                  \
+            if (const char* problem = checkValue(i, kv.value()))             \
+                errors.add(i, SerializationError::TYPE_MISMATCH, problem);   \
+        }                                                                    \
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {                           \
+            if (seen[i]) continue;                                           \
+            if (const char* problem = checkMissing(i))                       \
+                errors.add(i, SerializationError::FIELD_MISSING, problem);   \
+        }                                                                    \
+        return errors.empty();                                               \
+    }                                                                        \
+                                                                             \
+    /* Parses and validates the whole payload; out is filled only when valid */ \
+    static bool deserializeWithErrors(const String& jsonStr, structName& out, StructaErrorList& errors) { \
+        Document doc;                                                        \
+        MemoryTracker::Scope tracking(memoryStats(), MemoryTracker::DESERIALIZE, doc); \
+        if (!jsonFilterComplete()) {                                         \
+            errors.add(StructaFieldError::NO_FIELD, SerializationError::BUFFER_OVERFLOW, "Filter capacity exceeded"); \
+            return false;                                                    \
+        }                                                                    \
+        if (StructaJsonFormat::read(doc, jsonStr, jsonFilter())) {           \
+            errors.add(StructaFieldError::NO_FIELD, SerializationError::INVALID_JSON, "Parse error"); \
+            return false;                                                    \
+        }                                                                    \
+        JsonObject o = doc.as<JsonObject>();                                 \
+        bool valid = validateSchema(o, errors);                              \
+        if (valid) deserializeFields(o, out);                                \
+        return valid;                                                        \
+    }                                                                        \
+                                                                             \
+    STRUCTA_SCHEMA_PRINTER(structName)
+#else
+#define STRUCTA_FIELD_RULES(structName, FIELD_LIST)                          \
+    enum { HAS_RULES = false };                                              \
+    SerializationResult<void> validateSelf() const { return SerializationResult<void>::Success(); } \
+    static SerializationResult<void> validateSchema(const JsonObject&) { return SerializationResult<void>::Success(); } \
+    static SerializationResult<void> validatePatch(const JsonObject&) { return SerializationResult<void>::Success(); } \
+    static void printSchema(Print& = Serial) {}
+#endif
+
+// Everything DEFINE_STRUCTA and DEFINE_STRUCTA_WITH_VALIDATION share. The
+// including macro declares the members, the capacities, HAS_VALIDATORS and
+// validate(); validateData runs validate() after a read and is ignored by
+// structs without a validator list.
+#define STRUCTA_COMMON_METHODS(structName, FIELD_LIST)                       \
+    STRUCTA_FIELD_INDEX(FIELD_LIST)                                          \
+    static MemoryTracker::TypeStats& memoryStats() {                         \
+        static MemoryTracker::TypeStats stats(#structName, jsonCapacity);    \
+        return stats;                                                        \
+    }                                                                        \
+                                                                             \
+    STRUCTA_FIELD_METHODS(structName, FIELD_LIST)                            \
+    STRUCTA_VIEW(structName, FIELD_LIST)                                     \
+    STRUCTA_SCHEMA_MAP(structName, FIELD_LIST)                               \
+    STRUCTA_FIELD_RULES(structName, FIELD_LIST)                              \
+                                                                             \
+    SerializationResult<String> serializeWithResult() const {                \
+        Document doc;                                                        \
+        return writeString(doc, *this);                                      \
+    }                                                                        \
+                                                                             \
+    String serialize() const {                                               \
+        auto result = serializeWithResult();                                 \
+        return result.success ? std::move(result.data) : String("{}");       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeWithResult(char* buffer, size_t size) const { \
+        Document doc;                                                        \
+        return writeWith<Format>(doc, *this, buffer, size);                  \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeWithResult(Print& out) const {      \
+        Document doc;                                                        \
+        return writeWith<Format>(doc, *this, out);                           \
+    }                                                                        \
+                                                                             \
+    /* Context overloads reuse ctx's document; the String form leaves */     \
+    /* the JSON in ctx.output(), keeping its buffer between calls      */    \
+    SerializationResult<size_t> serializeWithResult(StructaContext& ctx) const { \
+        return writeWith(ctx, *this);                                        \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeWithResult(StructaContext& ctx, char* buffer, size_t size) const { \
+        return writeWith<Format>(ctx.document(), *this, buffer, size);       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeWithResult(StructaContext& ctx, Print& out) const { \
+        return writeWith<Format>(ctx.document(), *this, out);                \
+    }                                                                        \
+                                                                             \
+    size_t serialize(char* buffer, size_t size) const {                      \
+        auto result = serializeWithResult(buffer, size);                     \
+        return result.success ? result.data : 0;                             \
+    }                                                                        \
+                                                                             \
+    size_t serialize(Print& out) const {                                     \
+        auto result = serializeWithResult(out);                              \
+        return result.success ? result.data : 0;                             \
+    }                                                                        \
+    /* visitor(name, member) for each field, in FIELD_LIST order */          \
+    template<typename Visitor>                                               \
+    void forEachField(Visitor&& visitor) {                                   \
+        FIELD_LIST(VISIT_FIELD)                                              \
+    }                                                                        \
+                                                                             \
+    template<typename Visitor>                                               \
+    void forEachField(Visitor&& visitor) const {                             \
+        FIELD_LIST(VISIT_FIELD)                                              \
+    }                                                                        \
+                                                                             \
+    /* visitor(name, static_cast<const T*>(nullptr)): types only, no instance */ \
+    template<typename Visitor>                                               \
+    static void forEachFieldType(Visitor&& visitor) {                        \
+        FIELD_LIST(VISIT_FIELD_TYPE)                                         \
+    }                                                                        \
+    SerializationResult<String> serializeDelta(const structName& since) const { \
+        Document doc;                                                        \
+        return writeString(doc, Delta<structName>(*this, since));            \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeDelta(const structName& since, char* buffer, size_t size) const { \
+        Document doc;                                                        \
+        return writeWith<Format>(doc, Delta<structName>(*this, since), buffer, size); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeDelta(const structName& since, Print& out) const { \
+        Document doc;                                                        \
+        return writeWith<Format>(doc, Delta<structName>(*this, since), out); \
+    }                                                                        \
+                                                                             \
+    /* Merges a partial document; keys it does not carry are left as is */   \
+    /* (see patchWith) */                                                    \
+    SerializationResult<void> applyPatch(const JsonObject& o, bool validateData = true) { \
+        return mergePatch(o, *this, validateData);                           \
+    }                                                                        \
+                                                                             \
+    SerializationResult<void> applyPatch(const String& json, bool validateData = true) { \
+        return patchWith<structName, StructaJsonFormat>(*this, validateData, json); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<void> applyPatch(const char* json, bool validateData = true) { \
+        return patchWith<structName, Format>(*this, validateData, json);     \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<void> applyPatch(const uint8_t* input, size_t length, bool validateData = true) { \
+        return patchWith<structName, Format>(*this, validateData, input, length); \
+    }                                                                        \
+                                                                             \
+    /* Writes [item, item, ...], or a MessagePack array, reusing one */      \
+    /* document for every record; items is an array or anything indexable */ \
+    template<typename Format = StructaJsonFormat, typename Items>            \
+    static SerializationResult<size_t> serializeBatch(Items&& items, size_t count, Print& out) { \
+        return writeBatch<Format, structName>(items, count, out);            \
+    }                                                                        \
+                                                                             \
+    /* Reads a JSON array of records into items; data holds the count read */ \
+    static SerializationResult<size_t> deserializeBatch(Stream& in, structName* items, size_t maxItems, bool validateData = true) { \
+        auto result = readBatch(in, items, maxItems);                        \
+        if (!HAS_VALIDATORS || !result.success || !validateData) return result; \
+        for (size_t i = 0; i < result.data; ++i) {                           \
+            auto validationResult = items[i].validate();                     \
+            if (!validationResult.success) {                                 \
+                return SerializationResult<size_t>::Failure(validationResult.error.code, \
+                    validationResult.error.message, "[" + String(i) + "]." + validationResult.error.fieldPath); \
+            }                                                                \
+        }                                                                    \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    /* Keys kept while parsing, built on first use; complete is false when */ \
+    /* filterCapacity could not hold them all and every read then fails */   \
+    struct FilterState {                                                     \
+        StaticJsonDocument<filterCapacity> doc;                              \
+        bool complete;                                                       \
+        FilterState() : complete(fillFilter<structName>(doc)) {}             \
+    };                                                                       \
+    static const FilterState& filterState() {                                \
+        static const FilterState state;                                      \
+        return state;                                                        \
+    }                                                                        \
+    static const JsonDocument& jsonFilter() { return filterState().doc; }    \
+    static bool jsonFilterComplete() { return filterState().complete; }      \
+    /* Direct parser hook: reads one object from r into data */              \
+    static bool parseFields(StructaReader& r, structName& data) {            \
+        if (!r.beginObject()) return false;                                  \
+        StructaReader::Key key;                                              \
+        bool first = true;                                                   \
+        while (r.nextMember(key, first)) {                                   \
+            switch (StructaKey::hashRuntime(key)) {                          \
+                FIELD_LIST(PARSE_CASE)                                       \
+                default: break;                                              \
+            }                                                                \
+            if (!r.skipValue()) return false;                                \
+        }                                                                    \
+        return r.ok();                                                       \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<void> deserializeInto(structName& target, const JsonObject& o, bool validateData = true) { \
+        STRUCTA_CHECK_RULES(structName, SerializationResult<void>, validateSchema(o)) \
+        deserializeFields(o, target);                                        \
+        return checkValidation(target, SerializationResult<void>::Success(), validateData); \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<void> deserializeInto(structName& target, const String& jsonStr, bool validateData = true) { \
+        return checkValidation(target, readInto<structName, StructaJsonFormat>(target, jsonStr), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(structName& target, const char* json, bool validateData = true) { \
+        return checkValidation(target, readInto<structName, Format>(target, json), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(structName& target, const uint8_t* input, size_t length, bool validateData = true) { \
+        return checkValidation(target, readInto<structName, Format>(target, input, length), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(structName& target, Stream& in, bool validateData = true) { \
+        return checkValidation(target, readInto<structName, Format>(target, in), validateData); \
+    }                                                                        \
+    /* Direct parse: tokens go straight into members, no JsonDocument */     \
+    static SerializationResult<void> deserializeDirectInto(structName& target, const char* json, size_t length, bool validateData = true) { \
+        StructaReader reader(json, length);                                  \
+        return readDirectInto(reader, target, validateData);                 \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<void> deserializeDirectInto(structName& target, Stream& in, bool validateData = true) { \
+        StructaReader reader(in);                                            \
+        return readDirectInto(reader, target, validateData);                 \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeDirect(const char* json, size_t length, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeDirectInto(result.data, json, length, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeDirect(Stream& in, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeDirectInto(result.data, in, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+    static SerializationResult<void> deserializeInto(StructaContext& ctx, structName& target, const String& jsonStr, bool validateData = true) { \
+        return checkValidation(target, readWith<structName, StructaJsonFormat>(ctx.document(), target, jsonStr), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(StructaContext& ctx, structName& target, const char* json, bool validateData = true) { \
+        return checkValidation(target, readWith<structName, Format>(ctx.document(), target, json), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(StructaContext& ctx, structName& target, const uint8_t* input, size_t length, bool validateData = true) { \
+        return checkValidation(target, readWith<structName, Format>(ctx.document(), target, input, length), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<void> deserializeInto(StructaContext& ctx, structName& target, Stream& in, bool validateData = true) { \
+        return checkValidation(target, readWith<structName, Format>(ctx.document(), target, in), validateData); \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeWithResult(const String& jsonStr, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeInto(result.data, jsonStr, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeWithResult(const JsonObject& o, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeInto(result.data, o, validateData));     \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeWithResult(const char* json, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeInto<Format>(result.data, json, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeWithResult(const uint8_t* input, size_t length, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeInto<Format>(result.data, input, length, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeWithResult(Stream& in, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(deserializeInto<Format>(result.data, in, validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    /* Zero-copy: string values stay inside json (which is modified) until */ \
+    /* they are assigned into the struct's String members                  */ \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeInPlace(char* json, size_t length, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(checkValidation(result.data, readInto<structName, Format>(result.data, json, length), validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    SerializationResult<size_t> serializeMsgPack(uint8_t* buffer, size_t size) const { \
+        return serializeWithResult<StructaMsgPackFormat>(reinterpret_cast<char*>(buffer), size); \
+    }                                                                        \
+                                                                             \
+    SerializationResult<size_t> serializeMsgPack(Print& out) const {         \
+        return serializeWithResult<StructaMsgPackFormat>(out);               \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeMsgPack(const uint8_t* input, size_t length, bool validateData = true) { \
+        return deserializeWithResult<StructaMsgPackFormat>(input, length, validateData); \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeMsgPack(Stream& in, bool validateData = true) { \
+        return deserializeWithResult<StructaMsgPackFormat>(in, validateData); \
+    }                                                                        \
+                                                                             \
+    void serializeCompactInto(JsonArray& arr) const {                        \
+        FIELD_LIST(SERIALIZE_ELEMENT)                                        \
+    }                                                                        \
+                                                                             \
+    static void deserializeCompactFields(JsonArray::iterator it, const JsonArray::iterator& end, structName& data) { \
+        FIELD_LIST(DESERIALIZE_ELEMENT)                                      \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeCompact(char* buffer, size_t size) const { \
+        CompactDocument doc;                                                 \
+        MemoryTracker::Scope tracking(memoryStats(), MemoryTracker::SERIALIZE, doc); \
+        if(!fillCompactDocument(doc, *this)) {                               \
+            return SerializationResult<size_t>::Failure(                     \
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded"); \
+        }                                                                    \
+        auto result = writeOutput<Format>(doc, buffer, size);                \
+        if (result.success) tracking.output(result.data);                    \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    SerializationResult<size_t> serializeCompact(Print& out) const {         \
+        CompactDocument doc;                                                 \
+        MemoryTracker::Scope tracking(memoryStats(), MemoryTracker::SERIALIZE, doc); \
+        if(!fillCompactDocument(doc, *this)) {                               \
+            return SerializationResult<size_t>::Failure(                     \
+                SerializationError::BUFFER_OVERFLOW, "Document capacity exceeded"); \
+        }                                                                    \
+        auto result = writeOutput<Format>(doc, out);                         \
+        if (result.success) tracking.output(result.data);                    \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    static SerializationResult<structName> deserializeCompactWithResult(const JsonArray& arr, bool validateData = true) { \
+        return deserializeCompactWithResult(arr, StructaNoPeers<structName>(), validateData); \
+    }                                                                        \
+                                                                             \
+    /* Frames of other schemas decode through peers' tables */               \
+    template<typename Peers>                                                 \
+    static SerializationResult<structName> deserializeCompactWithResult(const JsonArray& arr, const Peers& peers, bool validateData = true) { \
+        SerializationResult<structName> result;                              \
+        result.setStatus(readCompactFrame(arr, result.data, peers));         \
+        if (!result.success) return result;                                  \
+        STRUCTA_CHECK_RULES(structName, SerializationResult<structName>, result.data.validateSelf()) \
+        result.setStatus(checkValidation(result.data, SerializationResult<void>::Success(), validateData)); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeCompact(const uint8_t* input, size_t length, bool validateData = true) { \
+        return deserializeCompact<Format>(input, length, StructaNoPeers<structName>(), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat, typename Peers>            \
+    static SerializationResult<structName> deserializeCompact(const uint8_t* input, size_t length, const Peers& peers, bool validateData = true) { \
+        typename Peers::FrameDocument doc;                                   \
+        MemoryTracker::Scope tracking(memoryStats(), MemoryTracker::DESERIALIZE, doc); \
+        DeserializationError err = Format::read(doc, input, length);         \
+        auto result = err ? parseFailure<structName>(err)                    \
+                          : deserializeCompactWithResult(doc.template as<JsonArray>(), peers, validateData); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat>                            \
+    static SerializationResult<structName> deserializeCompact(Stream& in, bool validateData = true) { \
+        return deserializeCompact<Format>(in, StructaNoPeers<structName>(), validateData); \
+    }                                                                        \
+                                                                             \
+    template<typename Format = StructaJsonFormat, typename Peers>            \
+    static SerializationResult<structName> deserializeCompact(Stream& in, const Peers& peers, bool validateData = true) { \
+        typename Peers::FrameDocument doc;                                   \
+        MemoryTracker::Scope tracking(memoryStats(), MemoryTracker::DESERIALIZE, doc); \
+        DeserializationError err = Format::read(doc, in);                    \
+        auto result = err ? parseFailure<structName>(err)                    \
+                          : deserializeCompactWithResult(doc.template as<JsonArray>(), peers, validateData); \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    static structName deserialize(const char* json, bool validateData = false) { \
+        auto result = deserializeWithResult(json, validateData);             \
+        return result.success ? std::move(result.data) : structName();       \
+    }                                                                        \
+                                                                             \
+    static structName deserialize(Stream& in, bool validateData = false) {   \
+        auto result = deserializeWithResult(in, validateData);               \
+        return result.success ? std::move(result.data) : structName();       \
+    }                                                                        \
+                                                                             \
+    static structName deserialize(const String& jsonStr, bool validateData = false) { \
+        auto result = deserializeWithResult(jsonStr, validateData);          \
+        return result.success ? std::move(result.data) : structName();       \
+    }                                                                        \
+                                                                             \
+    static structName deserialize(const JsonObject& o, bool validateData = false) { \
+        auto result = deserializeWithResult(o, validateData);                \
+        return result.success ? std::move(result.data) : structName();       \
+    }
+
+// ======================================================
+// Main Struct Definition Macro
+// ======================================================
+#define DEFINE_STRUCTA(structName, FIELD_LIST)                             \
+    DEFINE_STRUCTA_SIZED(structName, FIELD_LIST, STRUCTA_NO_HINTS)
+
+#define DEFINE_STRUCTA_SIZED(structName, FIELD_LIST, SIZE_HINTS)             \
+struct structName : public JsonStruct {                                      \
+    FIELD_LIST(DECLARE)                                                      \
+    DECLARE_CAPACITY(FIELD_LIST, SIZE_HINTS)                                 \
+                                                                             \
+    /* No validator list: validate() always succeeds */                      \
+    enum { HAS_VALIDATORS = false };                                         \
+    SerializationResult<bool> validate() const { return SerializationResult<bool>::Success(true); } \
+                                                                             \
+    STRUCTA_COMMON_METHODS(structName, FIELD_LIST)                           \
+    STRUCTA_PRINTERS(structName)                                             \
+};
+
+// Introspection printers for validated structs
+#if STRUCTA_INTROSPECTION
+#define STRUCTA_VALIDATION_PRINTERS(structName)                              \
+    static void printStructDefinition(Print& out = Serial) {                 \
+        out.println(STRUCTA_TEXT("=== " #structName " Struct Definition (WITH VALIDATION) ===")); \
+        out.println(STRUCTA_TEXT("Struct Name: " #structName));              \
+        out.println(STRUCTA_TEXT("Generated Methods:"));                     \
+        out.println(STRUCTA_TEXT("  - serialize() -> String"));              \
+        out.println(STRUCTA_TEXT("  - serializeWithResult() -> SerializationResult<String>")); \
+        out.println(STRUCTA_TEXT("  - serializeDelta(since[, out]) / applyPatch(json) (changed fields only)")); \
+        out.println(STRUCTA_TEXT("  - jsonFilter() -> const JsonDocument& (declared keys kept while parsing)")); \
+        out.println(STRUCTA_TEXT("  - jsonFilterComplete() -> bool (false if filterCapacity dropped keys)")); \
+        out.println(STRUCTA_TEXT("  - serialize(char*, size_t) / serialize(Print&) -> size_t")); \
+        out.println(STRUCTA_TEXT("  - serializeWithResult(char*, size_t) / (Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - serializeInto(JsonObject&) -> void")); \
+        out.println(STRUCTA_TEXT("  - deserialize(String, validate=false) -> " #structName)); \
+        out.println(STRUCTA_TEXT("  - deserialize(JsonObject, validate=false) -> " #structName)); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(String, validate=true) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(JsonObject, validate=true) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeWithResult(const char* | uint8_t*, size_t | Stream&, validate=true) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - deserializeInPlace(char*, size_t, validate=true) -> SerializationResult<" #structName "> (zero-copy)")); \
+        out.println(STRUCTA_TEXT("  - deserializeDirect(const char*, size_t | Stream&, validate=true) -> SerializationResult<" #structName "> (no document)")); \
+        out.println(STRUCTA_TEXT("  - deserializeInto(" #structName "&, input, validate=true) -> SerializationResult<void> (fills an existing instance)")); \
+        out.println(STRUCTA_TEXT("  - View(JsonObject | const char*, size_t): lazy getters, contains(), materialize()")); \
+        out.println(STRUCTA_TEXT("  - serializeWithResult(StructaContext&[, out]) / deserializeInto(StructaContext&, ...) (reuse a document)")); \
+        out.println(STRUCTA_TEXT("  - serializeMsgPack(uint8_t*, size_t | Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeMsgPack(const uint8_t*, size_t | Stream&, validate=true) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - serializeCompact<Format>(char*, size_t | Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - serializeBatch<Format>(const " #structName "*, size_t, Print&) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeBatch(Stream&, " #structName "*, size_t) -> SerializationResult<size_t>")); \
+        out.println(STRUCTA_TEXT("  - deserializeCompact<Format>(const uint8_t*, size_t | Stream&[, StructaSchemaCache&], validate=true) -> SerializationResult<" #structName ">")); \
+        out.println(STRUCTA_TEXT("  - serializeSchema<Format>(char*, size_t | Print&) -> SerializationResult<size_t> (for a peer's StructaSchemaCache)")); \
+        out.println(STRUCTA_TEXT("  - validate() -> SerializationResult<bool>")); \
+        out.println(STRUCTA_TEXT("  - forEachField(visitor) / forEachFieldType(visitor) (typed field walk)")); \
+        out.println(STRUCTA_TEXT("  - printStructDefinition(Print& = Serial) -> void")); \
+        out.println(STRUCTA_TEXT("  - printFieldInfo(Print& = Serial) / printCurrentValues(Print& = Serial) -> void")); \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Usage Example:"));                         \
+        out.println(STRUCTA_TEXT("  " #structName " obj;"));                 \
+        out.println(STRUCTA_TEXT("  String json = obj.serialize();"));       \
+        out.println(STRUCTA_TEXT("  auto result = " #structName "::deserializeWithResult(json);")); \
+        out.println(STRUCTA_TEXT("  if (!result.success) {"));               \
+        out.println(STRUCTA_TEXT("    out.println(result.error.toString());")); \
+        out.println(STRUCTA_TEXT("  }"));                                    \
+        out.println(STRUCTA_TEXT("=======================================")); \
+    }                                                                        \
+                                                                             \
+    static void printFieldInfo(Print& out = Serial) {                        \
+        out.println(STRUCTA_TEXT("=== " #structName " Field Information (WITH VALIDATION) ===")); \
+        out.println(STRUCTA_TEXT("This struct includes automatic validation on deserialization.")); \
+        out.println(STRUCTA_TEXT("Fields:"));                                \
+        forEachFieldType(StructaFieldInfoPrinter(out));                      \
+        out.print(STRUCTA_TEXT("Document capacity: "));                      \
+        out.print((unsigned long)jsonCapacity);                              \
+        out.println(STRUCTA_TEXT(" bytes"));                                 \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Validation is performed automatically in deserializeWithResult()")); \
+        out.println(STRUCTA_TEXT("You can also manually validate with: obj.validate()")); \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("For detailed macro writing guide with validation, call:")); \
+        out.println(STRUCTA_TEXT("MemoryTracker::showMacroWritingGuide();")); \
+        out.println(STRUCTA_TEXT("=========================================")); \
+    }                                                                        \
+                                                                             \
+    /* Streams the JSON and one line per field; no String or parse involved */ \
+    void printCurrentValues(Print& out = Serial) const {                     \
+        out.println(STRUCTA_TEXT("=== " #structName " Current Values ===")); \
+        out.println(STRUCTA_TEXT("JSON Representation:"));                   \
+        serialize(out);                                                      \
+        out.println();                                                       \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Formatted Output:"));                      \
+        MemoryTracker::recordOperation(memoryStats(), MemoryTracker::DIAGNOSTIC, 0, 0); \
+        forEachField(StructaFieldPrinter(out));                              \
+        out.println();                                                       \
+        out.println(STRUCTA_TEXT("Validation Status:"));                     \
+        auto validationResult = validate();                                  \
+        if (validationResult.success) {                                      \
+            out.println(STRUCTA_TEXT("  ✓ All validations passed"));         \
+        } else {                                                             \
+            out.println(STRUCTA_TEXT("  ✗ Validation failed:"));             \
+            out.print(STRUCTA_TEXT("    "));                                 \
+            out.println(validationResult.error.toString());                  \
+        }                                                                    \
+        out.println(STRUCTA_TEXT("====================================="));  \
+    }
+#else
+#define STRUCTA_VALIDATION_PRINTERS(structName) STRUCTA_PRINTER_STUBS
+#endif
+
+// ======================================================
+// NEW: Struct Definition WITH Validation Support
+// ======================================================
+#define DEFINE_STRUCTA_WITH_VALIDATION(structName, FIELD_LIST, VALIDATOR_LIST) \
+    DEFINE_STRUCTA_WITH_VALIDATION_SIZED(structName, FIELD_LIST, VALIDATOR_LIST, STRUCTA_NO_HINTS)
+
+#define DEFINE_STRUCTA_WITH_VALIDATION_SIZED(structName, FIELD_LIST, VALIDATOR_LIST, SIZE_HINTS) \
+struct structName : public JsonStruct {                                      \
+    FIELD_LIST(DECLARE)                                                      \
+    DECLARE_CAPACITY(FIELD_LIST, SIZE_HINTS)                                 \
+    VALIDATOR_LIST(DECLARE_VALIDATOR)                                        \
+                                                                             \
+    structName() {}                                                          \
+                                                                             \
+    enum { HAS_VALIDATORS = STRUCTA_VALIDATION };                            \
+    SerializationResult<bool> validate() const {                             \
+        VALIDATOR_LIST(VALIDATE_FIELD)                                       \
+        return SerializationResult<bool>::Success(true);                     \
+    }                                                                        \
+                                                                             \
+    STRUCTA_COMMON_METHODS(structName, FIELD_LIST)                           \
+    STRUCTA_VALIDATION_PRINTERS(structName)                                  \
+};
+
+// ======================================================
+// Helper Class for Guidance
+// ======================================================
+class StructaHelper {
+public:
+#if STRUCTA_INTROSPECTION
+    static void showMacroWritingGuide() {
+        Serial.println(STRUCTA_TEXT("╔════════════════════════════════════════════════════════╗"));
+        Serial.println(STRUCTA_TEXT("║        STRUCTA MACRO WRITING GUIDE                     ║"));
+        Serial.println(STRUCTA_TEXT("╚════════════════════════════════════════════════════════╝"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("1. BASIC SYNTAX"));
+        Serial.println(STRUCTA_TEXT("   #define STRUCT_NAME_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("       field(Type, name, META_RULE) \\"));
+        Serial.println(STRUCTA_TEXT("       field(Type, name, META_RULE) \\"));
+        Serial.println(STRUCTA_TEXT("       field(Type, name, META_RULE)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("   DEFINE_STRUCTA(StructName, STRUCT_NAME_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("2. FIELD PATTERN: field(TYPE, NAME[, METADATA])"));
+        Serial.println(STRUCTA_TEXT("   - TYPE: int, float, bool, String, or custom struct"));
+        Serial.println(STRUCTA_TEXT("   - NAME: variable identifier (camelCase recommended)"));
+        Serial.println(STRUCTA_TEXT("   - METADATA: optional validation rule (see section 5)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("3. IMPORTANT RULES"));
+        Serial.println(STRUCTA_TEXT("   ✓ Each line ends with \\ (except last line)"));
+        Serial.println(STRUCTA_TEXT("   ✓ NO semicolons at end of field lines"));
+        Serial.println(STRUCTA_TEXT("   ✓ NO commas between field definitions"));
+        Serial.println(STRUCTA_TEXT("   ✓ NO comments inside the macro"));
+        Serial.println(STRUCTA_TEXT("   ✓ 2 args per field, or 3 with a rule: (type, name[, meta])"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("4. CORRECT EXAMPLE"));
+        Serial.println(STRUCTA_TEXT("   #define USER_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("       field(String, username, META_STRLEN(3, 20)) \\"));
+        Serial.println(STRUCTA_TEXT("       field(int, age, META_RANGE(18, 100)) \\"));
+        Serial.println(STRUCTA_TEXT("       field(bool, active, META_NONE())"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("   DEFINE_STRUCTA(User, USER_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("5. METADATA OPTIONS"));
+        Serial.println(STRUCTA_TEXT("   (none) / META_NONE()  - No validation"));
+        Serial.println(STRUCTA_TEXT("   META_OPTIONAL()       - Optional, validated if present"));
+        Serial.println(STRUCTA_TEXT("   META_RANGE(min, max)  - Numeric range validation"));
+        Serial.println(STRUCTA_TEXT("   META_STRLEN(min, max) - String length validation"));
+        Serial.println(STRUCTA_TEXT("   META_ENUM(array)      - Enum value validation"));
+        Serial.println(STRUCTA_TEXT("   META_ENUM(Role::parse) - Names of a STRUCTA_ENUM"));
+        Serial.println(STRUCTA_TEXT("   META_SCALED(scale)    - Float sent as round(value * scale)"));
+        Serial.println(STRUCTA_TEXT("   META_FIXED(decimals)  - Float sent with fixed decimals (JSON)"));
+        Serial.println(STRUCTA_TEXT("   Encodings chain onto a rule: META_RANGE(-40, 85).fixed(1)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("6. SHORTHAND MACROS (Optional)"));
+        Serial.println(STRUCTA_TEXT("   Define once at top of file:"));
+        Serial.println(STRUCTA_TEXT("   #define V(t,n,m) field(t,n,m)  // Validated"));
+        Serial.println(STRUCTA_TEXT("   #define N(t,n) field(t,n,META_NONE())  // Not validated"));
+        Serial.println(STRUCTA_TEXT("   #define O(t,n) field(t,n,META_OPTIONAL())  // Optional"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("   Usage:"));
+        Serial.println(STRUCTA_TEXT("   #define USER_FIELDS(field)             \\"));
+        Serial.println(STRUCTA_TEXT("       V(String, name, META_STRLEN(3,20)) \\"));
+        Serial.println(STRUCTA_TEXT("       V(int, age, META_RANGE(18,100))    \\"));
+        Serial.println(STRUCTA_TEXT("       O(String, email)                   \\"));
+        Serial.println(STRUCTA_TEXT("       N(bool, internal)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("7. COMMON MISTAKES"));
+        Serial.println(STRUCTA_TEXT("   ✗ field(String, name,, META_NONE())  // double comma"));
+        Serial.println(STRUCTA_TEXT("   ✗ field(String, name, META_NONE());  // semicolon"));
+        Serial.println(STRUCTA_TEXT("   ✗ field(String, name, META_NONE()) \\  // comment"));
+        Serial.println(STRUCTA_TEXT("       field(int, age, META_NONE())  // missing \\"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("8. NESTED STRUCTS"));
+        Serial.println(STRUCTA_TEXT("   Define inner struct first:"));
+        Serial.println(STRUCTA_TEXT("   #define ADDRESS_FIELDS(field)              \\"));
+        Serial.println(STRUCTA_TEXT("       field(String, city, META_NONE())       \\"));
+        Serial.println(STRUCTA_TEXT("       field(int, zip, META_NONE())"));
+        Serial.println(STRUCTA_TEXT("   DEFINE_STRUCTA(Address, ADDRESS_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("   Then use in outer struct:"));
+        Serial.println(STRUCTA_TEXT("   #define USER_FIELDS(field)                 \\"));
+        Serial.println(STRUCTA_TEXT("       field(String, name, META_STRLEN(3,20)) \\"));
+        Serial.println(STRUCTA_TEXT("       field(Address, address, META_OPTIONAL())"));
+        Serial.println(STRUCTA_TEXT("   DEFINE_STRUCTA(User, USER_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("9. ENUM VALIDATION"));
+        Serial.println(STRUCTA_TEXT("   Declare array BEFORE field definition:"));
+        Serial.println(STRUCTA_TEXT("   const char* roles[] = {\"admin\", \"user\", \"guest\"};"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("   #define USER_FIELDS(field) \\"));
+        Serial.println(STRUCTA_TEXT("       field(String, role, META_ENUM(roles))"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("10. COMPLETE EXAMPLE"));
+        Serial.println(STRUCTA_TEXT("    const char* status[] = {\"active\", \"inactive\"};"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("    #define DEVICE_FIELDS(field)                    \\"));
+        Serial.println(STRUCTA_TEXT("        field(String, deviceId, META_STRLEN(5,20))  \\"));
+        Serial.println(STRUCTA_TEXT("        field(String, status, META_ENUM(status))    \\"));
+        Serial.println(STRUCTA_TEXT("        field(float, temp, META_RANGE(-40.0,125.0)) \\"));
+        Serial.println(STRUCTA_TEXT("        field(int, battery, META_RANGE(0,100))      \\"));
+        Serial.println(STRUCTA_TEXT("        field(bool, online, META_NONE())            \\"));
+        Serial.println(STRUCTA_TEXT("        field(String, notes, META_OPTIONAL())"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("    DEFINE_STRUCTA(Device, DEVICE_FIELDS)"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("════════════════════════════════════════════════════════"));
+    }
+
+    static void showQuickReference() {
+        Serial.println(STRUCTA_TEXT("╔═══════════════════════════════════╗"));
+        Serial.println(STRUCTA_TEXT("║  STRUCTA QUICK REFERENCE          ║"));
+        Serial.println(STRUCTA_TEXT("╚═══════════════════════════════════╝"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("VALIDATION MACROS:"));
+        Serial.println(STRUCTA_TEXT("  META_NONE()              No validation"));
+        Serial.println(STRUCTA_TEXT("  META_OPTIONAL()          Optional field"));
+        Serial.println(STRUCTA_TEXT("  META_RANGE(min, max)     Numeric range"));
+        Serial.println(STRUCTA_TEXT("  META_STRLEN(min, max)    String length"));
+        Serial.println(STRUCTA_TEXT("  META_ENUM(array)         Enum values"));
+        Serial.println(STRUCTA_TEXT("  META_ENUM(Enum::parse)   STRUCTA_ENUM names"));
+        Serial.println(STRUCTA_TEXT("  META_SCALED(scale)       Float as scaled integer"));
+        Serial.println(STRUCTA_TEXT("  META_FIXED(decimals)     Float with fixed decimals"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("SHORTHAND (define yourself):"));
+        Serial.println(STRUCTA_TEXT("  V(t,n,m)  Validated field"));
+        Serial.println(STRUCTA_TEXT("  N(t,n)    No validation"));
+        Serial.println(STRUCTA_TEXT("  O(t,n)    Optional"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("METHODS:"));
+        Serial.println(STRUCTA_TEXT("  .serialize()             → String"));
+        Serial.println(STRUCTA_TEXT("  .serializeWithResult()   → Result<String>"));
+        Serial.println(STRUCTA_TEXT("  ::deserialize(json)      → Struct"));
+        Serial.println(STRUCTA_TEXT("  ::deserializeWithResult(json) → Result<Struct>"));
+        Serial.println(STRUCTA_TEXT("  ::printSchema()          Show fields"));
+        Serial.println();
+        Serial.println(STRUCTA_TEXT("══════════════════════════════════"));
+    }
+#else
+    static void showMacroWritingGuide() {}
+    static void showQuickReference() {}
+#endif
 };
 
 #endif // STRUCTA_H
\ No newline at end of file